@@ -0,0 +1,101 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <type_safe/index.hpp> // index_t, index32_t, at()
+
+namespace ts = type_safe;
+
+// a graph in compressed sparse row format:
+// the neighbors of node i are targets[offsets[i]] to targets[offsets[i + 1]]
+// Index is either ts::index_t or ts::index32_t
+template <typename Index>
+struct csr_graph
+{
+    std::vector<Index> offsets;
+    std::vector<Index> targets;
+
+    std::size_t memory() const
+    {
+        return (offsets.size() + targets.size()) * sizeof(Index);
+    }
+};
+
+template <typename Index>
+csr_graph<Index> make_graph(std::size_t nodes, std::size_t degree)
+{
+    std::minstd_rand                           engine;
+    std::uniform_int_distribution<std::size_t> dist(0u, nodes - 1u);
+
+    csr_graph<Index> result;
+    result.offsets.reserve(nodes + 1u);
+    result.targets.reserve(nodes * degree);
+    for (std::size_t i = 0u; i != nodes; ++i)
+    {
+        // explicit conversion, checks that the index fits into Index
+        result.offsets.push_back(Index(ts::index_t(result.targets.size())));
+        for (std::size_t j = 0u; j != degree; ++j)
+            result.targets.push_back(Index(ts::index_t(dist(engine))));
+    }
+    result.offsets.push_back(Index(ts::index_t(result.targets.size())));
+    return result;
+}
+
+// breadth-first search from node 0, returns the number of reachable nodes
+template <typename Index>
+std::size_t traverse(const csr_graph<Index>& graph)
+{
+    std::vector<bool>  visited(graph.offsets.size() - 1u);
+    std::vector<Index> queue;
+    queue.reserve(visited.size());
+
+    queue.push_back(Index());
+    visited[0] = true;
+    for (std::size_t head = 0u; head != queue.size(); ++head)
+    {
+        auto node = queue[head];
+        // at() works for both index types
+        for (auto edge = at(graph.offsets, node); edge != at(graph.offsets, next(node)); ++edge)
+        {
+            auto target = at(graph.targets, edge);
+            auto seen   = at(visited, target);
+            if (!seen)
+            {
+                seen = true;
+                queue.push_back(target);
+            }
+        }
+    }
+    return queue.size();
+}
+
+template <typename Index>
+void run(const char* name, std::size_t nodes, std::size_t degree)
+{
+    auto graph = make_graph<Index>(nodes, degree);
+
+    auto start     = std::chrono::steady_clock::now();
+    auto reachable = traverse(graph);
+    auto end       = std::chrono::steady_clock::now();
+
+    std::cout << name << ": " << graph.memory() / (1024u * 1024u) << " MiB, " << reachable
+              << " nodes reached in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+              << " ms\n";
+}
+
+int main()
+{
+    const std::size_t nodes  = 1u << 22;
+    const std::size_t degree = 8u;
+
+    // same traversal, but index32_t needs only half the memory,
+    // so more of the graph fits into the cache
+    run<ts::index_t>("index_t  ", nodes, degree);
+    run<ts::index32_t>("index32_t", nodes, degree);
+}
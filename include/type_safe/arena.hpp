@@ -0,0 +1,329 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_ARENA_HPP_INCLUDED
+#define TYPE_SAFE_ARENA_HPP_INCLUDED
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <type_safe/config.hpp>
+#include <type_safe/constrained_type.hpp>
+#include <type_safe/detail/assert.hpp>
+#include <type_safe/reference.hpp>
+
+namespace type_safe
+{
+/// \exclude
+namespace detail
+{
+    constexpr std::size_t arena_alignment = alignof(std::max_align_t);
+    // memory of up to arena_size_classes * arena_alignment bytes is reused
+    constexpr std::size_t arena_size_classes = 16u;
+
+    constexpr std::size_t arena_round(std::size_t size) noexcept
+    {
+        return (size + arena_alignment - 1u) / arena_alignment * arena_alignment;
+    }
+
+    struct arena_block
+    {
+        arena_block* next;
+        std::size_t  size; // including the header
+    };
+
+    struct arena_free_node
+    {
+        arena_free_node* next;
+    };
+
+    // precedes every object with a non-trivial destructor or virtual functions
+    struct arena_object
+    {
+        void (*destroy)(void*) noexcept;
+        arena_object* prev;
+        arena_object* next;
+        std::size_t   size; // rounded, including the header
+    };
+
+    // objects without a header must be destroyed through a pointer to their exact type
+    template <typename T>
+    struct arena_headerless
+    : std::integral_constant<bool, std::is_trivially_destructible<T>::value
+                                       && !std::is_polymorphic<T>::value>
+    {};
+
+    constexpr std::size_t arena_block_header  = arena_round(sizeof(arena_block));
+    constexpr std::size_t arena_object_header = arena_round(sizeof(arena_object));
+
+    template <typename T>
+    void arena_destroy(void* ptr) noexcept
+    {
+        static_cast<T*>(ptr)->~T();
+    }
+
+    // address of the object created by the arena, ptr might point to a base class of it
+    template <typename T>
+    void* arena_created_object(std::true_type /* polymorphic */, T* ptr) noexcept
+    {
+#if TYPE_SAFE_USE_RTTI
+        return const_cast<void*>(dynamic_cast<const volatile void*>(ptr));
+#else
+        return const_cast<void*>(static_cast<const volatile void*>(ptr));
+#endif
+    }
+
+    template <typename T>
+    void* arena_created_object(std::false_type /* polymorphic */, T* ptr) noexcept
+    {
+        return const_cast<void*>(static_cast<const volatile void*>(ptr));
+    }
+} // namespace detail
+
+/// An arena that creates objects in large blocks of memory and destroys them all at once.
+///
+/// Objects are created with [*create]() and handed out as [ts::owner]() pointers.
+/// They can be destroyed individually with [*destroy](),
+/// then their memory is put into a free list for its size class and reused for new objects.
+/// But usually they are all destroyed by [*reset]() or the destructor:
+/// it calls only the destructors that are not trivial and then releases the memory in bulk,
+/// instead of deallocating every object.
+/// \notes It is not thread-safe, use one arena per thread,
+/// e.g. the one returned by [ts::this_thread_arena]().
+/// \requires The alignment of the objects must not be greater than `alignof(std::max_align_t)`.
+class arena
+{
+public:
+    /// \effects Creates an arena that allocates memory in blocks of the given size.
+    /// No memory is allocated yet.
+    explicit arena(std::size_t block_size = 4096u) noexcept
+    : blocks_(nullptr), objects_(nullptr), cur_(nullptr), end_(nullptr),
+      block_size_(detail::arena_round(block_size)), free_{}
+    {}
+
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+
+    /// \effects Destroys all objects and releases all memory.
+    ~arena() noexcept
+    {
+        reset();
+        if (blocks_)
+            ::operator delete(blocks_);
+    }
+
+    /// \effects Creates an object of type `T` by perfectly forwarding the arguments.
+    /// \returns An owning pointer to the object.
+    /// It must be destroyed using this arena, or not at all.
+    /// \throws [std::bad_alloc]() if no memory could be allocated,
+    /// or anything thrown by the constructor of `T`.
+    template <typename T, typename... Args>
+    owner<T*> create(Args&&... args)
+    {
+        static_assert(alignof(T) <= detail::arena_alignment, "over-aligned types not supported");
+        return owner<T*>(create_impl<T>(detail::arena_headerless<T>{},
+                                        std::forward<Args>(args)...));
+    }
+
+    /// \effects Destroys an object created by [*create]()
+    /// and makes its memory available for objects of a similar size.
+    /// It calls the destructor of the type the object was created with,
+    /// even if `T` is a base class of it.
+    /// \requires `ptr` must have been created by this arena since the last [*reset]().
+    /// If `T` is trivially destructible and has no virtual functions,
+    /// it must be the exact type the object was created with.
+    /// Otherwise it may also be a base class, if that class has virtual functions
+    /// or is at offset zero in the created type.
+    /// Without RTTI, it must always be at offset zero.
+    template <typename T>
+    void destroy(owner<T*> ptr) noexcept
+    {
+        destroy_impl(detail::arena_headerless<T>{}, ptr.get_value());
+    }
+
+    /// \effects Destroys all objects that have not been destroyed by [*destroy]() yet,
+    /// in reverse order of creation,
+    /// but it only needs to visit those with a non-trivial destructor.
+    /// Then it releases all memory except for one block, which will be reused.
+    /// \notes All pointers handed out by this arena are invalidated.
+    void reset() noexcept
+    {
+        for (auto cur = objects_; cur;)
+        {
+            auto next = cur->next;
+            cur->destroy(reinterpret_cast<char*>(cur) + detail::arena_object_header);
+            cur = next;
+        }
+        objects_ = nullptr;
+
+        for (auto& list : free_)
+            list = nullptr;
+
+        if (blocks_)
+        {
+            for (auto cur = blocks_->next; cur;)
+            {
+                auto next = cur->next;
+                ::operator delete(cur);
+                cur = next;
+            }
+            blocks_->next = nullptr;
+            cur_          = reinterpret_cast<char*>(blocks_) + detail::arena_block_header;
+            end_          = reinterpret_cast<char*>(blocks_) + blocks_->size;
+        }
+    }
+
+    /// \returns The number of blocks allocated.
+    std::size_t block_count() const noexcept
+    {
+        std::size_t result = 0u;
+        for (auto cur = blocks_; cur; cur = cur->next)
+            ++result;
+        return result;
+    }
+
+private:
+    // constructs the object at memory + offset, deallocates the memory if it throws
+    template <typename T, typename... Args>
+    T* construct(char* memory, std::size_t offset, std::size_t size, Args&&... args)
+    {
+        T* result = nullptr;
+        TYPE_SAFE_TRY
+        {
+            result = ::new (static_cast<void*>(memory + offset)) T(std::forward<Args>(args)...);
+        }
+        TYPE_SAFE_CATCH_ALL
+        {
+            deallocate(memory, size);
+            TYPE_SAFE_RETHROW;
+        }
+        return result;
+    }
+
+    template <typename T, typename... Args>
+    T* create_impl(std::true_type, Args&&... args)
+    {
+        return construct<T>(allocate(sizeof(T)), 0u, sizeof(T), std::forward<Args>(args)...);
+    }
+
+    template <typename T, typename... Args>
+    T* create_impl(std::false_type, Args&&... args)
+    {
+        auto size   = detail::arena_round(detail::arena_object_header + sizeof(T));
+        auto memory = allocate(size);
+        // if the constructor throws, the object isn't linked into the list yet
+        auto result = construct<T>(memory, detail::arena_object_header, size,
+                                   std::forward<Args>(args)...);
+
+        auto object     = ::new (static_cast<void*>(memory)) detail::arena_object;
+        object->destroy = &detail::arena_destroy<T>;
+        object->prev    = nullptr;
+        object->next    = objects_;
+        object->size    = size;
+        if (objects_)
+            objects_->prev = object;
+        objects_ = object;
+
+        return result;
+    }
+
+    template <typename T>
+    void destroy_impl(std::true_type, T* ptr) noexcept
+    {
+        ptr->~T();
+        deallocate(reinterpret_cast<char*>(ptr), sizeof(T));
+    }
+
+    template <typename T>
+    void destroy_impl(std::false_type, T* ptr) noexcept
+    {
+        auto created = detail::arena_created_object(std::is_polymorphic<T>{}, ptr);
+        auto memory  = static_cast<char*>(created) - detail::arena_object_header;
+        auto object  = reinterpret_cast<detail::arena_object*>(memory);
+        if (object->prev)
+            object->prev->next = object->next;
+        else
+            objects_ = object->next;
+        if (object->next)
+            object->next->prev = object->prev;
+
+        object->destroy(created);
+        deallocate(memory, object->size);
+    }
+
+    char* allocate(std::size_t size)
+    {
+        size = detail::arena_round(size);
+
+        auto size_class = size / detail::arena_alignment - 1u;
+        if (size_class < detail::arena_size_classes && free_[size_class])
+        {
+            auto node         = free_[size_class];
+            free_[size_class] = node->next;
+            return reinterpret_cast<char*>(node);
+        }
+
+        if (static_cast<std::size_t>(end_ - cur_) < size)
+            allocate_block(size);
+        auto result = cur_;
+        cur_ += size;
+        return result;
+    }
+
+    void deallocate(char* memory, std::size_t size) noexcept
+    {
+        auto size_class = detail::arena_round(size) / detail::arena_alignment - 1u;
+        if (size_class < detail::arena_size_classes)
+        {
+            auto node         = ::new (memory) detail::arena_free_node;
+            node->next        = free_[size_class];
+            free_[size_class] = node;
+        }
+        // bigger memory is only released by reset()
+    }
+
+    void allocate_block(std::size_t min_size)
+    {
+        auto size = detail::arena_block_header
+                    + (min_size > block_size_ ? min_size : block_size_);
+        auto block = ::new (::operator new(size)) detail::arena_block;
+        block->next = blocks_;
+        block->size = size;
+
+        blocks_ = block;
+        cur_    = reinterpret_cast<char*>(block) + detail::arena_block_header;
+        end_    = reinterpret_cast<char*>(block) + size;
+    }
+
+    detail::arena_block*     blocks_;
+    detail::arena_object*    objects_;
+    char*                    cur_;
+    char*                    end_;
+    std::size_t              block_size_;
+    detail::arena_free_node* free_[detail::arena_size_classes];
+};
+
+/// \returns The [ts::arena]() of the current thread.
+/// \notes It is created on first use and destroyed when the thread exits,
+/// call [ts::arena::reset]() to release the objects earlier.
+inline arena& this_thread_arena() noexcept
+{
+    static thread_local arena a;
+    return a;
+}
+
+/// \returns A non-owning [ts::object_ref]() to the object owned by `ptr`.
+/// \requires `ptr` must not be `nullptr`.
+template <typename T>
+object_ref<T> borrow(const owner<T*>& ptr) noexcept
+{
+    DEBUG_ASSERT(ptr.get_value() != nullptr, detail::precondition_error_handler{},
+                 "borrowing null pointer");
+    return object_ref<T>(*ptr.get_value());
+}
+} // namespace type_safe
+
+#endif // TYPE_SAFE_ARENA_HPP_INCLUDED
@@ -0,0 +1,287 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_ARRAY_VIEW_HPP_INCLUDED
+#define TYPE_SAFE_ARRAY_VIEW_HPP_INCLUDED
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include <type_safe/detail/assert.hpp>
+#include <type_safe/index.hpp>
+#include <type_safe/reference.hpp>
+
+namespace type_safe
+{
+/// \exclude
+namespace detail
+{
+    // stores the index instead of a pointer to the current element,
+    // the element one stride past the last one may be outside of the array
+    template <typename T, bool XValue>
+    class strided_iterator
+    {
+    public:
+        using value_type        = typename std::remove_cv<T>::type;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = T*;
+        using reference         = typename std::conditional<XValue, T&&, T&>::type;
+        using iterator_category = std::forward_iterator_tag;
+
+        strided_iterator() noexcept : ptr_(nullptr), index_(0u), stride_(0u) {}
+
+        strided_iterator(T* ptr, std::size_t index, std::size_t stride) noexcept
+        : ptr_(ptr), index_(index), stride_(stride)
+        {}
+
+        reference operator*() const noexcept
+        {
+            return static_cast<reference>(*operator->());
+        }
+
+        pointer operator->() const noexcept
+        {
+            return ptr_ + index_ * stride_;
+        }
+
+        strided_iterator& operator++() noexcept
+        {
+            ++index_;
+            return *this;
+        }
+
+        strided_iterator operator++(int) noexcept
+        {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+
+        friend bool operator==(const strided_iterator& a, const strided_iterator& b) noexcept
+        {
+            return a.index_ == b.index_;
+        }
+
+        friend bool operator!=(const strided_iterator& a, const strided_iterator& b) noexcept
+        {
+            return !(a == b);
+        }
+
+    private:
+        T*          ptr_;
+        std::size_t index_;
+        std::size_t stride_;
+    };
+
+    template <typename T, bool XValue>
+    class chunk_iterator
+    {
+    public:
+        using value_type        = array_ref<T, XValue>;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = void;
+        using reference         = array_ref<T, XValue>;
+        using iterator_category = std::input_iterator_tag;
+
+        chunk_iterator(T* ptr, T* end, std::size_t chunk_size) noexcept
+        : ptr_(ptr), end_(end), chunk_size_(chunk_size)
+        {}
+
+        array_ref<T, XValue> operator*() const noexcept
+        {
+            return array_ref<T, XValue>(ptr_, cur_size());
+        }
+
+        chunk_iterator& operator++() noexcept
+        {
+            ptr_ += cur_size();
+            return *this;
+        }
+
+        chunk_iterator operator++(int) noexcept
+        {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+
+        friend bool operator==(const chunk_iterator& a, const chunk_iterator& b) noexcept
+        {
+            return a.ptr_ == b.ptr_;
+        }
+
+        friend bool operator!=(const chunk_iterator& a, const chunk_iterator& b) noexcept
+        {
+            return !(a == b);
+        }
+
+    private:
+        std::size_t cur_size() const noexcept
+        {
+            auto remaining = static_cast<std::size_t>(end_ - ptr_);
+            return remaining < chunk_size_ ? remaining : chunk_size_;
+        }
+
+        T*          ptr_;
+        T*          end_;
+        std::size_t chunk_size_;
+    };
+} // namespace detail
+
+/// A reference to every `stride`th element of an array of objects of type `T`.
+///
+/// It is like [ts::array_ref](), but the elements are `stride` elements apart,
+/// for example a column of a row-major matrix.
+/// It is created by [ts::strided]().
+/// \notes `XValue` has the same meaning as in [ts::array_ref]().
+template <typename T, bool XValue = false>
+class strided_array_ref
+{
+public:
+    using value_type     = T;
+    using reference_type = typename std::conditional<XValue, T&&, T&>::type;
+    using iterator       = detail::strided_iterator<T, XValue>;
+
+    /// \effects Sets the reference to the `size` elements
+    /// `array[0]`, `array[stride]`, `array[2 * stride]` and so on.
+    /// \requires `array` must not be `nullptr` unless `size` is `0`,
+    /// and `stride` must not be `0`.
+    strided_array_ref(T* array, size_t size, size_t stride) noexcept
+    : begin_(array), size_(size), stride_(stride)
+    {
+        DEBUG_ASSERT(size == 0u || array, detail::precondition_error_handler{},
+                     "invalid array bounds");
+        DEBUG_ASSERT(stride != 0u, detail::precondition_error_handler{}, "stride must not be 0");
+    }
+
+    /// \returns An iterator to the first element.
+    iterator begin() const noexcept
+    {
+        return iterator(begin_, 0u, static_cast<std::size_t>(stride_));
+    }
+
+    /// \returns An iterator one past the last element.
+    iterator end() const noexcept
+    {
+        return iterator(begin_, static_cast<std::size_t>(size_),
+                        static_cast<std::size_t>(stride_));
+    }
+
+    /// \returns A pointer to the first element.
+    T* data() const noexcept
+    {
+        return begin_;
+    }
+
+    /// \returns The number of elements.
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    /// \returns The distance between two elements in the underlying array.
+    size_t stride() const noexcept
+    {
+        return stride_;
+    }
+
+    /// \returns A (`rvalue` if `Xvalue` is `true`) reference to the `i`th element.
+    /// \requires `i < size()`.
+    reference_type operator[](index_t i) const noexcept
+    {
+        DEBUG_ASSERT(static_cast<size_t&>(i) < size_, detail::precondition_error_handler{},
+                     "out of bounds array access");
+        return static_cast<reference_type>(
+            begin_[static_cast<std::size_t>(static_cast<size_t&>(i) * stride_)]);
+    }
+
+private:
+    T*     begin_;
+    size_t size_;
+    size_t stride_;
+};
+
+/// \returns A [ts::strided_array_ref]() to every `stride`th element of `ref`,
+/// starting with the first one.
+/// \notes To get the `i`th column of a row-major matrix with `n` columns,
+/// use `strided(ref.subspan(i), n)`.
+/// \requires `stride` must not be `0`.
+template <typename T, bool XValue>
+strided_array_ref<T, XValue> strided(const array_ref<T, XValue>& ref, size_t stride) noexcept
+{
+    DEBUG_ASSERT(stride != 0u, detail::precondition_error_handler{}, "stride must not be 0");
+    return strided_array_ref<T, XValue>(ref.data(), (ref.size() + stride - 1u) / stride, stride);
+}
+
+/// The range of [ts::array_ref]() slices of an array, created by [ts::chunks]().
+///
+/// Each slice has the same size, except for the last one, which may be smaller.
+/// \notes `XValue` has the same meaning as in [ts::array_ref]().
+template <typename T, bool XValue = false>
+class chunk_range
+{
+public:
+    using iterator = detail::chunk_iterator<T, XValue>;
+
+    /// \effects Splits `ref` into slices of `chunk_size` elements.
+    /// \requires `chunk_size` must not be `0`.
+    chunk_range(const array_ref<T, XValue>& ref, size_t chunk_size) noexcept
+    : ref_(ref), chunk_size_(chunk_size)
+    {
+        DEBUG_ASSERT(chunk_size != 0u, detail::precondition_error_handler{},
+                     "chunk size must not be 0");
+    }
+
+    /// \returns An iterator to the first slice.
+    iterator begin() const noexcept
+    {
+        return iterator(ref_.begin(), ref_.end(), static_cast<std::size_t>(chunk_size_));
+    }
+
+    /// \returns An iterator one past the last slice.
+    iterator end() const noexcept
+    {
+        return iterator(ref_.end(), ref_.end(), static_cast<std::size_t>(chunk_size_));
+    }
+
+    /// \returns The number of slices.
+    size_t size() const noexcept
+    {
+        return (ref_.size() + chunk_size_ - 1u) / chunk_size_;
+    }
+
+    /// \returns Whether or not there are no slices.
+    bool empty() const noexcept
+    {
+        return ref_.size() == 0u;
+    }
+
+    /// \returns The `i`th slice.
+    /// \requires `i < size()`.
+    array_ref<T, XValue> operator[](index_t i) const noexcept
+    {
+        DEBUG_ASSERT(static_cast<size_t&>(i) < size(), detail::precondition_error_handler{},
+                     "out of bounds chunk access");
+        auto offset = static_cast<size_t&>(i) * chunk_size_;
+        auto count  = ref_.size() - offset;
+        return ref_.subspan(offset, count < chunk_size_ ? count : chunk_size_);
+    }
+
+private:
+    array_ref<T, XValue> ref_;
+    size_t               chunk_size_;
+};
+
+/// \returns The [ts::chunk_range]() splitting `ref` into slices of `chunk_size` elements.
+/// \notes Choose the `chunk_size` so that a slice fits into the cache.
+/// \requires `chunk_size` must not be `0`.
+template <typename T, bool XValue>
+chunk_range<T, XValue> chunks(const array_ref<T, XValue>& ref, size_t chunk_size) noexcept
+{
+    return chunk_range<T, XValue>(ref, chunk_size);
+}
+} // namespace type_safe
+
+#endif // TYPE_SAFE_ARRAY_VIEW_HPP_INCLUDED
@@ -0,0 +1,275 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_ATOMIC_FLAG_HPP_INCLUDED
+#define TYPE_SAFE_ATOMIC_FLAG_HPP_INCLUDED
+
+#include <atomic>
+#include <type_traits>
+
+#include <type_safe/detail/assert.hpp>
+#include <type_safe/flag.hpp>
+#include <type_safe/flag_set.hpp>
+
+namespace type_safe
+{
+/// A [ts::flag]() that can be modified atomically.
+///
+/// It provides the same interface as [ts::flag](),
+/// but all operations are lock-free atomic read-modify-write operations,
+/// so it can be shared between multiple threads.
+/// Every operation takes the [std::memory_order]() to use,
+/// which defaults to [std::memory_order_seq_cst]().
+/// \notes Unlike [std::atomic_flag]() it can be queried without modification.
+/// \module types
+class atomic_flag
+{
+public:
+    atomic_flag() = delete;
+
+    /// \effects Gives the flag the initial state.
+    /// \notes This function does not participate in overload resolution if `T` is not a boolean
+    /// type. \param 1 \exclude
+    template <typename T, typename = detail::enable_boolean<T>>
+    constexpr atomic_flag(T initial_state) noexcept
+    : state_(static_cast<bool>(initial_state) ? 1u : 0u)
+    {}
+
+    atomic_flag(const atomic_flag&) = delete;
+    atomic_flag& operator=(const atomic_flag&) = delete;
+
+    /// \returns The current state.
+    bool load(std::memory_order order = std::memory_order_seq_cst) const noexcept
+    {
+        return state_.load(order) != 0u;
+    }
+
+    /// \effects Atomically flips the state of the flag.
+    /// \returns The old value.
+    bool toggle(std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return state_.fetch_xor(1u, order) != 0u;
+    }
+
+    /// \effects Atomically sets its state to the new one.
+    /// \requires The new state must be different than the old one.
+    /// \param 1
+    /// \exclude
+    template <typename T, typename = detail::enable_boolean<T>>
+    void change(T new_state, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        auto old = state_.exchange(static_cast<bool>(new_state) ? 1u : 0u, order) != 0u;
+        DEBUG_ASSERT(old != static_cast<bool>(new_state), detail::precondition_error_handler{});
+        (void)old;
+    }
+
+    /// \effects Atomically sets its state to `true`.
+    /// \returns The previous state.
+    bool set(std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return state_.fetch_or(1u, order) != 0u;
+    }
+
+    /// \effects Atomically sets its state to `true`.
+    /// \returns `true` if the previous state was `false`, `false` otherwise,
+    /// i.e. whether or not the state was changed.
+    /// Only one of multiple threads calling it concurrently will get `true`.
+    bool try_set(std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return !set(order);
+    }
+
+    /// \effects Atomically sets its state to `false`.
+    /// \returns The previous state.
+    bool reset(std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return state_.fetch_and(0u, order) != 0u;
+    }
+
+    /// \effects Atomically sets its state to `false`.
+    /// \returns `true` if the previous state was `true`, `false` otherwise,
+    /// i.e. whether or not the state was changed.
+    /// Only one of multiple threads calling it concurrently will get `true`.
+    bool try_reset(std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return reset(order);
+    }
+
+private:
+    // std::atomic<bool> doesn't provide fetch_xor() and friends
+    std::atomic<unsigned char> state_;
+};
+
+/// A [ts::flag_set]() that can be modified atomically.
+///
+/// All operations are lock-free atomic operations on a single integer,
+/// so it can be used for flags shared between multiple threads.
+/// Every operation takes the [std::memory_order]() to use,
+/// which defaults to [std::memory_order_seq_cst]().
+///
+/// \requires `Enum` must be a flag,
+/// i.e. valid with the [ts::flag_set_traits](),
+/// and the flags must fit into a single integer.
+template <typename Enum>
+class atomic_flag_set
+{
+    static_assert(std::is_enum<Enum>::value, "not an enum");
+    static_assert(flag_set_traits<Enum>::value, "invalid enum for flag_set");
+    static_assert(detail::has_flag_set_int<flag_set_traits<Enum>::size()>::value,
+                  "too many flags for atomic_flag_set");
+
+    using int_type = typename detail::flag_set_bits<flag_set_traits<Enum>::size()>::int_type;
+
+public:
+    //=== constructors ===//
+    /// \effects Creates a set where all flags are set to `0`.
+    /// \group ctor_null
+    constexpr atomic_flag_set() noexcept : bits_(int_type(0u)) {}
+
+    /// \group ctor_null
+    constexpr atomic_flag_set(noflag_t) noexcept : atomic_flag_set() {}
+
+    /// \effects Creates a set with the same flags as the given set.
+    atomic_flag_set(const flag_set<Enum>& set) noexcept : bits_(to_int(set)) {}
+
+    atomic_flag_set(const atomic_flag_set&) = delete;
+    atomic_flag_set& operator=(const atomic_flag_set&) = delete;
+
+    //=== whole set ===//
+    /// \returns The current flags.
+    flag_set<Enum> load(std::memory_order order = std::memory_order_seq_cst) const noexcept
+    {
+        return from_int(bits_.load(order));
+    }
+
+    /// \effects Atomically replaces the current flags with the given ones.
+    void store(const flag_set<Enum>& set,
+               std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        bits_.store(to_int(set), order);
+    }
+
+    /// \effects Atomically replaces the current flags with the given ones.
+    /// \returns The previous flags.
+    flag_set<Enum> exchange(const flag_set<Enum>& set,
+                            std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return from_int(bits_.exchange(to_int(set), order));
+    }
+
+    /// \effects Atomically replaces the current flags with `to`,
+    /// if they are exactly `from`.
+    /// \returns Whether or not the flags have been replaced.
+    /// \notes This is the state transition of a state machine.
+    /// It will not fail spuriously.
+    /// \group transition
+    bool transition(const flag_set<Enum>& from, const flag_set<Enum>& to,
+                    std::memory_order success, std::memory_order failure) noexcept
+    {
+        auto expected = to_int(from);
+        return bits_.compare_exchange_strong(expected, to_int(to), success, failure);
+    }
+
+    /// \group transition
+    bool transition(const flag_set<Enum>& from, const flag_set<Enum>& to,
+                    std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        auto expected = to_int(from);
+        return bits_.compare_exchange_strong(expected, to_int(to), order);
+    }
+
+    //=== flag operation ===//
+    /// \effects Atomically sets the specified flag to `1`.
+    /// \returns The previous state of the flag.
+    bool set(const Enum& flag, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return (bits_.fetch_or(to_int(flag), order) & to_int(flag)) != int_type(0u);
+    }
+
+    /// \effects Atomically sets the specified flag to `1`.
+    /// \returns `true` if the flag was `0` before, `false` otherwise,
+    /// i.e. whether or not the flag was changed.
+    /// Only one of multiple threads calling it concurrently will get `true`.
+    bool try_set(const Enum& flag, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return !set(flag, order);
+    }
+
+    /// \effects Atomically sets the specified flag to `0`.
+    /// \returns The previous state of the flag.
+    bool reset(const Enum& flag, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return (bits_.fetch_and(int_type(~to_int(flag)), order) & to_int(flag)) != int_type(0u);
+    }
+
+    /// \effects Atomically sets the specified flag to `0`.
+    /// \returns `true` if the flag was `1` before, `false` otherwise,
+    /// i.e. whether or not the flag was changed.
+    /// Only one of multiple threads calling it concurrently will get `true`.
+    bool try_reset(const Enum& flag, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return reset(flag, order);
+    }
+
+    /// \effects Atomically toggles the specified flag.
+    /// \returns The previous state of the flag.
+    bool toggle(const Enum& flag, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return (bits_.fetch_xor(to_int(flag), order) & to_int(flag)) != int_type(0u);
+    }
+
+    /// \returns Whether or not the specified flag is set.
+    bool is_set(const Enum& flag, std::memory_order order = std::memory_order_seq_cst) const
+        noexcept
+    {
+        return load(order).is_set(flag);
+    }
+
+    //=== bitwise operations ===//
+    /// \effects Atomically sets all flags that are set in the given flag combination.
+    /// \returns The previous flags.
+    /// \notes This function does not participate in overload resolution,
+    /// unless the argument is a flag combination.
+    template <typename FlagCombo, typename = detail::enable_flag_combo<FlagCombo, Enum>>
+    flag_set<Enum> fetch_or(const FlagCombo& other,
+                            std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return from_int(bits_.fetch_or(to_int(other), order));
+    }
+
+    /// \effects Atomically toggles all flags that are set in the given flag combination.
+    /// \returns The previous flags.
+    /// \notes This function does not participate in overload resolution,
+    /// unless the argument is a flag combination.
+    template <typename FlagCombo, typename = detail::enable_flag_combo<FlagCombo, Enum>>
+    flag_set<Enum> fetch_xor(const FlagCombo& other,
+                             std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return from_int(bits_.fetch_xor(to_int(other), order));
+    }
+
+    /// \effects Atomically clears all flags that aren't set in the given flag mask.
+    /// \returns The previous flags.
+    flag_set<Enum> fetch_and(const flag_mask<Enum>& other,
+                             std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return from_int(bits_.fetch_and(to_int(combo(other)), order));
+    }
+
+private:
+    static int_type to_int(const flag_set<Enum>& set) noexcept
+    {
+        return set.template to_int<int_type>();
+    }
+
+    static flag_set<Enum> from_int(int_type bits) noexcept
+    {
+        return flag_combo<Enum>::from_int(bits);
+    }
+
+    std::atomic<int_type> bits_;
+};
+} // namespace type_safe
+
+#endif // TYPE_SAFE_ATOMIC_FLAG_HPP_INCLUDED
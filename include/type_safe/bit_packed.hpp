@@ -0,0 +1,518 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_BIT_PACKED_HPP_INCLUDED
+#define TYPE_SAFE_BIT_PACKED_HPP_INCLUDED
+
+#include <climits>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <type_safe/boolean.hpp>
+#include <type_safe/bounded_type.hpp>
+#include <type_safe/detail/assert.hpp>
+#include <type_safe/flag.hpp>
+#include <type_safe/flag_set.hpp>
+
+namespace type_safe
+{
+/// \exclude
+namespace detail
+{
+    // number of bits required to store all values in the range [0, max]
+    constexpr std::size_t bit_width(std::uintmax_t max) noexcept
+    {
+        return max == 0u ? 0u : 1u + bit_width(max >> 1);
+    }
+
+    // a field storing a static interval as offset from the smallest valid value
+    template <typename T, bool LowerInclusive, bool UpperInclusive, typename LowerBound,
+              typename UpperBound>
+    struct bit_packed_bounds
+    {
+        static_assert(std::is_integral<T>::value, "bounded field must be integral");
+        static_assert(!constraints::detail::is_dynamic<LowerBound>::value
+                          && !constraints::detail::is_dynamic<UpperBound>::value,
+                      "bounded field requires static bounds");
+
+        static constexpr std::uintmax_t min_value = static_cast<std::uintmax_t>(
+            T(LowerInclusive ? LowerBound::value : LowerBound::value + 1));
+        static constexpr std::uintmax_t max_value = static_cast<std::uintmax_t>(
+            T(UpperInclusive ? UpperBound::value : UpperBound::value - 1));
+
+        static constexpr std::size_t width = bit_width(max_value - min_value);
+
+        static constexpr std::uintmax_t encode_value(const T& value) noexcept
+        {
+            return static_cast<std::uintmax_t>(value) - min_value;
+        }
+
+        static constexpr T decode_value(std::uintmax_t bits) noexcept
+        {
+            return T(min_value + bits);
+        }
+    };
+
+    // bits are stored little endian: bit i is bit i % CHAR_BIT of byte i / CHAR_BIT
+    inline std::uintmax_t read_bits(const unsigned char* bytes, std::size_t offset,
+                                    std::size_t width) noexcept
+    {
+        std::uintmax_t result = 0u;
+        for (std::size_t i = 0u; i != width;)
+        {
+            auto bit   = offset + i;
+            auto shift = bit % CHAR_BIT;
+            auto count = CHAR_BIT - shift < width - i ? CHAR_BIT - shift : width - i;
+
+            auto chunk = (unsigned(bytes[bit / CHAR_BIT]) >> shift) & ((1u << count) - 1u);
+            result |= std::uintmax_t(chunk) << i;
+            i += count;
+        }
+        return result;
+    }
+
+    inline void write_bits(unsigned char* bytes, std::size_t offset, std::size_t width,
+                           std::uintmax_t value) noexcept
+    {
+        for (std::size_t i = 0u; i != width;)
+        {
+            auto bit   = offset + i;
+            auto shift = bit % CHAR_BIT;
+            auto count = CHAR_BIT - shift < width - i ? CHAR_BIT - shift : width - i;
+
+            auto  mask  = ((1u << count) - 1u) << shift;
+            auto  chunk = unsigned(value >> i) << shift;
+            auto& byte  = bytes[bit / CHAR_BIT];
+            byte        = static_cast<unsigned char>((byte & ~mask) | (chunk & mask));
+            i += count;
+        }
+    }
+} // namespace detail
+
+/// Traits for the fields of a [ts::bit_packed]() record.
+///
+/// For each type that should be used as a field it must provide the following interface:
+/// * `static constexpr std::size_t width`, the number of bits required to store the field,
+/// at most the number of bits in [std::uintmax_t]().
+/// * `static std::uintmax_t encode(const T&)`, which returns the bits of the given value.
+/// * `static T decode(std::uintmax_t)`, which creates a value from the bits.
+/// It must verify the value, as the bits could come from a buffer containing anything.
+///
+/// It is specialized for [ts::boolean](), [ts::flag](), [ts::flag_set](), flags, i.e. enums valid
+/// with the [ts::flag_set_traits](), as well as [ts::bounded_type]() and
+/// [ts::compact_bounded_type]() with static bounds.
+/// Bounded types store the offset from the smallest valid value
+/// and thus only need the bits for the width of the interval.
+/// Flags store the value of the enumerator,
+/// decoding throws a [ts::constrain_error]() if it is not less than the size.
+template <typename T, typename = void>
+struct bit_packed_traits;
+
+/// \exclude
+template <>
+struct bit_packed_traits<boolean>
+{
+    static constexpr std::size_t width = 1u;
+
+    static constexpr std::uintmax_t encode(const boolean& b) noexcept
+    {
+        return static_cast<bool>(b) ? 1u : 0u;
+    }
+
+    static constexpr boolean decode(std::uintmax_t bits) noexcept
+    {
+        return bits != 0u;
+    }
+};
+
+/// \exclude
+template <>
+struct bit_packed_traits<flag>
+{
+    static constexpr std::size_t width = 1u;
+
+    static constexpr std::uintmax_t encode(const flag& f) noexcept
+    {
+        return f == true ? 1u : 0u;
+    }
+
+    static constexpr flag decode(std::uintmax_t bits) noexcept
+    {
+        return flag(bits != 0u);
+    }
+};
+
+/// \exclude
+template <typename Enum>
+struct bit_packed_traits<Enum, typename std::enable_if<flag_set_traits<Enum>::value>::type>
+{
+    static constexpr std::size_t width = detail::bit_width(flag_set_traits<Enum>::size() - 1u);
+
+    static constexpr std::uintmax_t encode(const Enum& e) noexcept
+    {
+        return static_cast<std::uintmax_t>(e);
+    }
+
+    static Enum decode(std::uintmax_t bits)
+    {
+        if (bits >= flag_set_traits<Enum>::size())
+            TYPE_SAFE_THROW(constrain_error{});
+        return static_cast<Enum>(bits);
+    }
+};
+
+/// \exclude
+template <typename Enum>
+struct bit_packed_traits<flag_set<Enum>>
+{
+    static_assert(detail::has_flag_set_int<flag_set_traits<Enum>::size()>::value,
+                  "too many flags for a bit_packed field");
+
+    static constexpr std::size_t width = flag_set_traits<Enum>::size();
+
+    static constexpr std::uintmax_t encode(const flag_set<Enum>& set) noexcept
+    {
+        return set.template to_int<std::uintmax_t>();
+    }
+
+    static flag_set<Enum> decode(std::uintmax_t bits) noexcept
+    {
+        using int_type = typename detail::flag_set_bits<flag_set_traits<Enum>::size()>::int_type;
+        return flag_combo<Enum>::from_int(int_type(bits));
+    }
+};
+
+/// \exclude
+template <typename T, bool LowerInclusive, bool UpperInclusive, typename LowerBound,
+          typename UpperBound, typename Verifier>
+struct bit_packed_traits<bounded_type<T, LowerInclusive, UpperInclusive, LowerBound, UpperBound,
+                                      Verifier>>
+{
+    using type
+        = bounded_type<T, LowerInclusive, UpperInclusive, LowerBound, UpperBound, Verifier>;
+    using bounds = detail::bit_packed_bounds<T, LowerInclusive, UpperInclusive, LowerBound,
+                                             UpperBound>;
+
+    static constexpr std::size_t width = bounds::width;
+
+    static constexpr std::uintmax_t encode(const type& value) noexcept
+    {
+        return bounds::encode_value(value.get_value());
+    }
+
+    static constexpr type decode(std::uintmax_t bits)
+    {
+        return type(bounds::decode_value(bits));
+    }
+};
+
+/// \exclude
+template <typename T, bool LowerInclusive, bool UpperInclusive, typename LowerBound,
+          typename UpperBound, typename Verifier>
+struct bit_packed_traits<compact_bounded_type<T, LowerInclusive, UpperInclusive, LowerBound,
+                                              UpperBound, Verifier>>
+{
+    using type   = compact_bounded_type<T, LowerInclusive, UpperInclusive, LowerBound, UpperBound,
+                                      Verifier>;
+    using bounds = detail::bit_packed_bounds<T, LowerInclusive, UpperInclusive, LowerBound,
+                                             UpperBound>;
+
+    static constexpr std::size_t width = bounds::width;
+
+    static constexpr std::uintmax_t encode(const type& value) noexcept
+    {
+        return value.get_offset();
+    }
+
+    static constexpr type decode(std::uintmax_t bits)
+    {
+        return type(bounds::decode_value(bits));
+    }
+};
+
+/// \exclude
+namespace detail
+{
+    template <typename T>
+    struct bit_packed_width : std::integral_constant<std::size_t, bit_packed_traits<T>::width>
+    {
+        static_assert(bit_packed_traits<T>::width <= sizeof(std::uintmax_t) * CHAR_BIT,
+                      "bit_packed field too big");
+    };
+
+    // sum of the widths of the first I fields
+    template <std::size_t I, typename... Fields>
+    struct bit_packed_offset : std::integral_constant<std::size_t, 0u>
+    {};
+
+    template <std::size_t I, typename Head, typename... Tail>
+    struct bit_packed_offset<I, Head, Tail...>
+    : std::integral_constant<std::size_t,
+                             I == 0u ? 0u
+                                     : bit_packed_width<Head>::value
+                                           + bit_packed_offset<I - 1u, Tail...>::value>
+    {};
+
+    template <typename Field, typename... Fields>
+    struct bit_packed_count : std::integral_constant<std::size_t, 0u>
+    {};
+
+    template <typename Field, typename Head, typename... Tail>
+    struct bit_packed_count<Field, Head, Tail...>
+    : std::integral_constant<std::size_t, std::is_same<Field, Head>::value
+                                              + bit_packed_count<Field, Tail...>::value>
+    {};
+
+    template <typename Field, typename... Fields>
+    struct bit_packed_index : std::integral_constant<std::size_t, 0u>
+    {};
+
+    template <typename Field, typename Head, typename... Tail>
+    struct bit_packed_index<Field, Head, Tail...>
+    : std::integral_constant<std::size_t, std::is_same<Field, Head>::value
+                                              ? 0u
+                                              : 1u + bit_packed_index<Field, Tail...>::value>
+    {};
+
+    // provides the accessors given the bytes of the Derived class
+    template <class Derived, typename... Fields>
+    class bit_packed_getter
+    {
+    public:
+        /// The number of bits of all fields.
+        static constexpr std::size_t bit_size
+            = bit_packed_offset<sizeof...(Fields), Fields...>::value;
+        /// The number of bytes of all fields.
+        static constexpr std::size_t byte_size = (bit_size + CHAR_BIT - 1u) / CHAR_BIT;
+
+        /// The type of the `I`th field.
+        template <std::size_t I>
+        using field_type = typename std::tuple_element<I, std::tuple<Fields...>>::type;
+
+        /// \returns The value of the `I`th field (1)/the field of type `Field` (2).
+        /// \throws Anything thrown by the verification of the field.
+        /// \requires `Field` must occur exactly once in the `Fields`.
+        /// \group get
+        template <std::size_t I>
+        field_type<I> get() const
+        {
+            using traits = bit_packed_traits<field_type<I>>;
+            return traits::decode(
+                read_bits(bytes(), bit_packed_offset<I, Fields...>::value, traits::width));
+        }
+
+        /// \group get
+        template <typename Field>
+        Field get() const
+        {
+            static_assert(bit_packed_count<Field, Fields...>::value == 1u,
+                          "field must occur exactly once");
+            return get<bit_packed_index<Field, Fields...>::value>();
+        }
+
+    protected:
+        const unsigned char* bytes() const noexcept
+        {
+            return static_cast<const Derived&>(*this).get_bytes();
+        }
+
+        ~bit_packed_getter() = default;
+    };
+
+    template <class Derived, typename... Fields>
+    constexpr std::size_t bit_packed_getter<Derived, Fields...>::bit_size;
+    template <class Derived, typename... Fields>
+    constexpr std::size_t bit_packed_getter<Derived, Fields...>::byte_size;
+
+    template <class Derived, typename... Fields>
+    class bit_packed_setter : public bit_packed_getter<Derived, Fields...>
+    {
+        using getter = bit_packed_getter<Derived, Fields...>;
+
+    public:
+        /// \effects Sets the `I`th field (1, 3)/the field of type `Field` (2, 4) to the given
+        /// value. (3) and (4) create the field from the arguments first, which verifies them.
+        /// \throws Anything thrown by the creation of the field.
+        /// \requires `Field` must occur exactly once in the `Fields`.
+        /// \group set
+        template <std::size_t I>
+        void set(const typename getter::template field_type<I>& value) noexcept
+        {
+            write<I>(value);
+        }
+
+        /// \group set
+        template <typename Field>
+        void set(const Field& value) noexcept
+        {
+            static_assert(bit_packed_count<Field, Fields...>::value == 1u,
+                          "field must occur exactly once");
+            write<bit_packed_index<Field, Fields...>::value>(value);
+        }
+
+        /// \group set
+        template <std::size_t I, typename... Args>
+        void set(Args&&... args)
+        {
+            write<I>(typename getter::template field_type<I>(std::forward<Args>(args)...));
+        }
+
+        /// \group set
+        template <typename Field, typename... Args>
+        void set(Args&&... args)
+        {
+            static_assert(bit_packed_count<Field, Fields...>::value == 1u,
+                          "field must occur exactly once");
+            write<bit_packed_index<Field, Fields...>::value>(Field(std::forward<Args>(args)...));
+        }
+
+    protected:
+        unsigned char* bytes() noexcept
+        {
+            return static_cast<Derived&>(*this).get_bytes();
+        }
+
+        ~bit_packed_setter() = default;
+
+    private:
+        template <std::size_t I>
+        void write(const typename getter::template field_type<I>& value) noexcept
+        {
+            using traits = bit_packed_traits<typename getter::template field_type<I>>;
+            write_bits(bytes(), bit_packed_offset<I, Fields...>::value, traits::width,
+                       traits::encode(value));
+        }
+    };
+} // namespace detail
+
+/// A record of multiple fields that are stored in the minimal number of bits.
+///
+/// Every field is stored in the number of bits given by the [ts::bit_packed_traits](),
+/// e.g. a [ts::bounded_type]() with the bounds `[0, 100]` only requires seven bits
+/// and a [ts::flag]() a single bit.
+/// The fields are stored one after the other in a byte array,
+/// starting with the least significant bit of the first byte.
+/// The fields are accessed with `get<Field>()` and `set<Field>()`,
+/// or `get<I>()` and `set<I>()` if a type occurs more than once.
+///
+/// Use [ts::bit_packed_ref]() and [ts::bit_packed_cref]() to access an existing buffer,
+/// e.g. a network packet, with the same layout.
+/// \requires Every field must have a specialization of the [ts::bit_packed_traits]().
+template <typename... Fields>
+class bit_packed : public detail::bit_packed_setter<bit_packed<Fields...>, Fields...>
+{
+    using base = detail::bit_packed_setter<bit_packed<Fields...>, Fields...>;
+
+public:
+    /// \effects Creates it with all bits zero,
+    /// this is the smallest value of each field.
+    bit_packed() noexcept : bytes_{} {}
+
+    /// \returns A pointer to the [*byte_size]() bytes storing the record.
+    /// \group data
+    unsigned char* data() noexcept
+    {
+        return bytes_;
+    }
+
+    /// \group data
+    const unsigned char* data() const noexcept
+    {
+        return bytes_;
+    }
+
+private:
+    unsigned char* get_bytes() noexcept
+    {
+        return bytes_;
+    }
+    const unsigned char* get_bytes() const noexcept
+    {
+        return bytes_;
+    }
+
+    unsigned char bytes_[base::byte_size == 0u ? 1u : base::byte_size];
+
+    friend detail::bit_packed_getter<bit_packed, Fields...>;
+    friend detail::bit_packed_setter<bit_packed, Fields...>;
+};
+
+/// A reference to a buffer that is interpreted as a [ts::bit_packed]() record.
+///
+/// It provides the same accessors as [ts::bit_packed]() for the record stored in the buffer.
+/// \requires Every field must have a specialization of the [ts::bit_packed_traits]().
+template <typename... Fields>
+class bit_packed_ref : public detail::bit_packed_setter<bit_packed_ref<Fields...>, Fields...>
+{
+public:
+    /// \effects Creates a reference to the buffer.
+    /// \requires `bytes` must point to at least [*byte_size]() bytes.
+    explicit bit_packed_ref(unsigned char* bytes) noexcept : bytes_(bytes)
+    {
+        DEBUG_ASSERT(bytes_, detail::precondition_error_handler{}, "nullptr buffer");
+    }
+
+    /// \effects Creates a reference to the given record.
+    bit_packed_ref(bit_packed<Fields...>& record) noexcept : bytes_(record.data()) {}
+
+    /// \returns A pointer to the buffer.
+    unsigned char* data() const noexcept
+    {
+        return bytes_;
+    }
+
+private:
+    unsigned char* get_bytes() const noexcept
+    {
+        return bytes_;
+    }
+
+    unsigned char* bytes_;
+
+    friend detail::bit_packed_getter<bit_packed_ref, Fields...>;
+    friend detail::bit_packed_setter<bit_packed_ref, Fields...>;
+};
+
+/// A `const` reference to a buffer that is interpreted as a [ts::bit_packed]() record.
+///
+/// It provides the `get()` accessors of [ts::bit_packed]() for the record stored in the buffer.
+/// \requires Every field must have a specialization of the [ts::bit_packed_traits]().
+template <typename... Fields>
+class bit_packed_cref : public detail::bit_packed_getter<bit_packed_cref<Fields...>, Fields...>
+{
+public:
+    /// \effects Creates a reference to the buffer.
+    /// \requires `bytes` must point to at least [*byte_size]() bytes.
+    explicit bit_packed_cref(const unsigned char* bytes) noexcept : bytes_(bytes)
+    {
+        DEBUG_ASSERT(bytes_, detail::precondition_error_handler{}, "nullptr buffer");
+    }
+
+    /// \effects Creates a reference to the given record.
+    bit_packed_cref(const bit_packed<Fields...>& record) noexcept : bytes_(record.data()) {}
+
+    /// \effects Creates a reference to the same buffer.
+    bit_packed_cref(const bit_packed_ref<Fields...>& ref) noexcept : bytes_(ref.data()) {}
+
+    /// \returns A pointer to the buffer.
+    const unsigned char* data() const noexcept
+    {
+        return bytes_;
+    }
+
+private:
+    const unsigned char* get_bytes() const noexcept
+    {
+        return bytes_;
+    }
+
+    const unsigned char* bytes_;
+
+    friend detail::bit_packed_getter<bit_packed_cref, Fields...>;
+};
+} // namespace type_safe
+
+#endif // TYPE_SAFE_BIT_PACKED_HPP_INCLUDED
@@ -10,6 +10,7 @@
 #include <type_traits>
 #include <utility>
 
+#include <type_safe/config.hpp>
 #include <type_safe/detail/force_inline.hpp>
 
 namespace type_safe
@@ -165,6 +166,49 @@ std::basic_ostream<Char, CharTraits>& operator<<(std::basic_ostream<Char, CharTr
     return out << static_cast<bool>(b);
 }
 
+//=== select ===//
+/// \exclude
+namespace detail
+{
+    template <typename T>
+    TYPE_SAFE_FORCE_INLINE constexpr T select(std::true_type /* integral */, bool cond, T a,
+                                              T b) noexcept
+    {
+        // mask is all ones if cond is true, all zeros otherwise
+        return T(b ^ ((a ^ b) & (T(0) - T(cond))));
+    }
+
+    template <typename T>
+    TYPE_SAFE_FORCE_INLINE TYPE_SAFE_CONSTEXPR14 T select(std::false_type /* integral */,
+                                                          bool cond, T a, T b) noexcept
+    {
+        // index instead of ?:, as that is compiled to a branch for floating points
+        const T values[] = {b, a};
+        return values[cond];
+    }
+
+    template <typename T>
+    using enable_select = typename std::enable_if<std::is_arithmetic<T>::value
+                                                  && !std::is_same<T, bool>::value>::type;
+} // namespace detail
+
+/// Branch-free selection of a value.
+/// \returns `a` if `cond` is `true`, `b` otherwise.
+/// \notes Unlike `cond ? a : b` it is guaranteed to be implemented without a conditional jump,
+/// which is faster if `cond` is unpredictable.
+/// There are overloads for [ts::integer](), [ts::floating_point]() and [ts::strong_typedef]()
+/// as well.
+/// \notes This function does not participate in overload resolution,
+/// unless `T` is a built-in arithmetic type other than `bool`.
+/// \module types
+/// \param 1
+/// \exclude
+template <typename T, typename = detail::enable_select<T>>
+TYPE_SAFE_FORCE_INLINE TYPE_SAFE_CONSTEXPR14 T select(boolean cond, T a, T b) noexcept
+{
+    return detail::select(std::is_integral<T>{}, static_cast<bool>(cond), a, b);
+}
+
 //=== comparison functors ===//
 /// \exclude
 #define TYPE_SAFE_DETAIL_MAKE_PREDICATE(Name, Op)                                                  \
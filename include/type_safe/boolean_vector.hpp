@@ -0,0 +1,388 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_BOOLEAN_VECTOR_HPP_INCLUDED
+#define TYPE_SAFE_BOOLEAN_VECTOR_HPP_INCLUDED
+
+#include <cstdint>
+#include <vector>
+
+#include <type_safe/boolean.hpp>
+#include <type_safe/detail/assert.hpp>
+#include <type_safe/detail/bit_words.hpp>
+#include <type_safe/flag_set.hpp>
+
+namespace type_safe
+{
+/// A dynamic array of [ts::boolean]() values, stored with one bit per element.
+///
+/// It is the type safe version of `std::vector<bool>`:
+/// elements are accessed through a proxy reference that only converts to [ts::boolean](),
+/// never to an integer.
+/// In addition, it provides bulk operations that work on 64 elements at a time,
+/// and conversion from and to the bit pattern of a [ts::flag_set]().
+/// It is also the result of the queries on a [ts::flag_set_column]().
+/// \module types
+class boolean_vector
+{
+    using word = detail::bit_word;
+
+    static constexpr std::size_t word_bits = detail::bit_word_bits;
+
+public:
+    using value_type      = boolean;
+    using const_reference = boolean;
+    using size_type       = std::size_t;
+
+    /// A proxy reference to an element of a [ts::boolean_vector]().
+    class reference
+    {
+    public:
+        /// \effects Assigns the given value to the element.
+        /// \notes This function does not participate in overload resolution,
+        /// unless `T` is a boolean type.
+        /// \param 1
+        /// \exclude
+        template <typename T, typename = detail::enable_boolean<T>>
+        reference& operator=(T value) noexcept
+        {
+            *word_ = word((*word_ & ~mask_) | (mask_ & word(word(0u) - static_cast<bool>(value))));
+            return *this;
+        }
+
+        /// \effects Assigns the value of the other element to this element.
+        reference& operator=(const reference& other) noexcept
+        {
+            return *this = boolean(other);
+        }
+
+        /// \returns The value of the element.
+        operator boolean() const noexcept
+        {
+            return (*word_ & mask_) != word(0u);
+        }
+
+        /// \returns The value of the element.
+        explicit operator bool() const noexcept
+        {
+            return (*word_ & mask_) != word(0u);
+        }
+
+        /// \returns The inverted value of the element.
+        boolean operator!() const noexcept
+        {
+            return !boolean(*this);
+        }
+
+        /// \effects Inverts the value of the element.
+        void flip() noexcept
+        {
+            *word_ ^= mask_;
+        }
+
+    private:
+        reference(word* w, word mask) noexcept : word_(w), mask_(mask) {}
+
+        word* word_;
+        word  mask_;
+
+        friend boolean_vector;
+    };
+
+    //=== constructors ===//
+    /// \effects Creates an empty vector.
+    boolean_vector() noexcept : size_(0u) {}
+
+    /// \effects Creates a vector of `size` elements that all have the given value.
+    explicit boolean_vector(std::size_t size, boolean value = false)
+    : words_(word_count(size), word(word(0u) - static_cast<bool>(value))), size_(size)
+    {
+        clear_unused();
+    }
+
+    /// \effects Creates a vector with one element per flag,
+    /// the `i`th element is `true` if the `i`th flag is set.
+    template <typename Enum>
+    explicit boolean_vector(const flag_set<Enum>& set)
+    : boolean_vector(flag_set_traits<Enum>::size())
+    {
+        assign_flags(detail::has_flag_set_int<flag_set_traits<Enum>::size()>{}, set);
+    }
+
+    //=== access ===//
+    /// \returns The number of elements.
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    /// \returns Whether or not there are no elements.
+    bool empty() const noexcept
+    {
+        return size_ == 0u;
+    }
+
+    /// \returns A proxy reference (1)/the value (2) of the `i`th element.
+    /// \requires `i < size()`.
+    /// \group index
+    reference operator[](std::size_t i) noexcept
+    {
+        DEBUG_ASSERT(i < size_, detail::precondition_error_handler{}, "out of bounds access");
+        return reference(&words_[i / word_bits], mask(i));
+    }
+
+    /// \group index
+    boolean operator[](std::size_t i) const noexcept
+    {
+        DEBUG_ASSERT(i < size_, detail::precondition_error_handler{}, "out of bounds access");
+        return (words_[i / word_bits] & mask(i)) != word(0u);
+    }
+
+    /// \returns The number of elements that are `true`.
+    std::size_t count() const noexcept
+    {
+        return detail::count_set_bits(words_.data(), words_.size());
+    }
+
+    /// \returns Whether any (1)/all (2)/no (3) element is `true`.
+    /// \group any_all_none
+    bool any() const noexcept
+    {
+        word result(0u);
+        for (auto w : words_)
+            result |= w;
+        return result != word(0u);
+    }
+
+    /// \group any_all_none
+    bool all() const noexcept
+    {
+        return count() == size_;
+    }
+
+    /// \group any_all_none
+    bool none() const noexcept
+    {
+        return !any();
+    }
+
+    /// \returns The index of the first element that is `true` and whose index is `>= pos`,
+    /// or `size()` if there is none.
+    std::size_t find_first(std::size_t pos = 0u) const noexcept
+    {
+        return detail::find_set_bit(words_.data(), size_, pos);
+    }
+
+    /// \effects Invokes `f` with the index of every element that is `true`, in increasing order.
+    /// \notes The cost is proportional to the number of `true` elements,
+    /// not the number of all elements.
+    template <typename Func>
+    void for_each_set(Func&& f) const
+    {
+        detail::for_each_set_bit(words_.data(), words_.size(), f);
+    }
+
+    /// \returns A [ts::flag_set]() where the `i`th flag is set if the `i`th element is `true`.
+    /// \requires `size()` must be the number of flags.
+    template <typename Enum>
+    flag_set<Enum> to_flag_set() const noexcept
+    {
+        DEBUG_ASSERT(size_ == flag_set_traits<Enum>::size(), detail::precondition_error_handler{},
+                     "size does not match number of flags");
+        return to_flags<Enum>(detail::has_flag_set_int<flag_set_traits<Enum>::size()>{});
+    }
+
+    //=== modifiers ===//
+    /// \effects Appends an element with the given value.
+    void push_back(boolean value)
+    {
+        if (size_ % word_bits == 0u)
+            words_.push_back(word(0u));
+        words_.back() |= word(word(static_cast<bool>(value)) << (size_ % word_bits));
+        ++size_;
+    }
+
+    /// \effects Removes the last element.
+    /// \requires `!empty()`.
+    void pop_back() noexcept
+    {
+        DEBUG_ASSERT(!empty(), detail::precondition_error_handler{}, "empty vector");
+        --size_;
+        if (size_ % word_bits == 0u)
+            words_.pop_back();
+        else
+            clear_unused();
+    }
+
+    /// \effects Changes the number of elements to `size`,
+    /// new elements get the given value.
+    void resize(std::size_t size, boolean value = false)
+    {
+        auto fill = word(word(0u) - static_cast<bool>(value));
+        if (size > size_ && size_ % word_bits != 0u)
+            // fill the remaining bits of the current last word
+            words_.back() |= word(fill << (size_ % word_bits));
+
+        words_.resize(word_count(size), fill);
+        size_ = size;
+        clear_unused();
+    }
+
+    /// \effects Removes all elements.
+    void clear() noexcept
+    {
+        words_.clear();
+        size_ = 0u;
+    }
+
+    /// \effects Inverts all elements.
+    void flip() noexcept
+    {
+        for (auto& w : words_)
+            w = word(~w);
+        clear_unused();
+    }
+
+    //=== bulk operations ===//
+    /// \effects Sets every element to the result of `Op` applied to it
+    /// and the element of `other` with the same index.
+    /// \returns `*this`
+    /// \requires `other.size() == size()`.
+    /// \group compound_op
+    boolean_vector& operator&=(const boolean_vector& other) noexcept
+    {
+        DEBUG_ASSERT(other.size_ == size_, detail::precondition_error_handler{},
+                     "vectors of different size");
+        for (std::size_t i = 0u; i != words_.size(); ++i)
+            words_[i] &= other.words_[i];
+        return *this;
+    }
+
+    /// \group compound_op
+    boolean_vector& operator|=(const boolean_vector& other) noexcept
+    {
+        DEBUG_ASSERT(other.size_ == size_, detail::precondition_error_handler{},
+                     "vectors of different size");
+        for (std::size_t i = 0u; i != words_.size(); ++i)
+            words_[i] |= other.words_[i];
+        return *this;
+    }
+
+    /// \group compound_op
+    boolean_vector& operator^=(const boolean_vector& other) noexcept
+    {
+        DEBUG_ASSERT(other.size_ == size_, detail::precondition_error_handler{},
+                     "vectors of different size");
+        for (std::size_t i = 0u; i != words_.size(); ++i)
+            words_[i] ^= other.words_[i];
+        return *this;
+    }
+
+    /// \effects Sets every element that is `true` in `other` to `false`,
+    /// i.e. the same as `*this &= ~other` without the temporary.
+    /// \returns `*this`
+    /// \requires `other.size() == size()`.
+    boolean_vector& and_not(const boolean_vector& other) noexcept
+    {
+        DEBUG_ASSERT(other.size_ == size_, detail::precondition_error_handler{},
+                     "vectors of different size");
+        for (std::size_t i = 0u; i != words_.size(); ++i)
+            words_[i] &= word(~other.words_[i]);
+        return *this;
+    }
+
+    /// \returns A vector where all elements are inverted.
+    boolean_vector operator~() const
+    {
+        auto result = *this;
+        result.flip();
+        return result;
+    }
+
+    /// \returns The same as `a Op= b`.
+    /// \group binary_op
+    friend boolean_vector operator&(boolean_vector a, const boolean_vector& b)
+    {
+        return a &= b;
+    }
+
+    /// \group binary_op
+    friend boolean_vector operator|(boolean_vector a, const boolean_vector& b)
+    {
+        return a |= b;
+    }
+
+    /// \group binary_op
+    friend boolean_vector operator^(boolean_vector a, const boolean_vector& b)
+    {
+        return a ^= b;
+    }
+
+    /// `boolean_vector` equality comparison.
+    /// \returns Whether both vectors have the same elements.
+    /// \group equal
+    friend bool operator==(const boolean_vector& a, const boolean_vector& b) noexcept
+    {
+        return a.size_ == b.size_ && a.words_ == b.words_;
+    }
+
+    /// \group equal
+    friend bool operator!=(const boolean_vector& a, const boolean_vector& b) noexcept
+    {
+        return !(a == b);
+    }
+
+private:
+    static std::size_t word_count(std::size_t size) noexcept
+    {
+        return detail::bit_word_count(size);
+    }
+
+    static word mask(std::size_t i) noexcept
+    {
+        return word(word(1u) << (i % word_bits));
+    }
+
+    // bits after the last element must always be zero
+    void clear_unused() noexcept
+    {
+        if (size_ % word_bits != 0u)
+            words_.back() &= detail::last_bit_word_mask(size_);
+    }
+
+    // flags fit into a single integer, copy it directly
+    template <typename Enum>
+    void assign_flags(std::true_type, const flag_set<Enum>& set) noexcept
+    {
+        words_[0] = set.template to_int<word>();
+    }
+
+    template <typename Enum>
+    void assign_flags(std::false_type, const flag_set<Enum>& set) noexcept
+    {
+        set.for_each_set([&](const Enum& f) { (*this)[static_cast<std::size_t>(f)] = true; });
+    }
+
+    template <typename Enum>
+    flag_set<Enum> to_flags(std::true_type) const noexcept
+    {
+        using int_type = typename detail::flag_set_bits<flag_set_traits<Enum>::size()>::int_type;
+        return flag_combo<Enum>::from_int(int_type(words_[0]));
+    }
+
+    template <typename Enum>
+    flag_set<Enum> to_flags(std::false_type) const noexcept
+    {
+        flag_set<Enum> result;
+        for (auto i = find_first(); i != size_; i = find_first(i + 1u))
+            result.set(static_cast<Enum>(i));
+        return result;
+    }
+
+    std::vector<word> words_;
+    std::size_t       size_;
+};
+} // namespace type_safe
+
+#endif // TYPE_SAFE_BOOLEAN_VECTOR_HPP_INCLUDED
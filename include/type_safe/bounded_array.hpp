@@ -0,0 +1,215 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_BOUNDED_ARRAY_HPP_INCLUDED
+#define TYPE_SAFE_BOUNDED_ARRAY_HPP_INCLUDED
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <type_safe/bounded_type.hpp>
+#include <type_safe/constrained_range.hpp>
+#include <type_safe/detail/assert.hpp>
+#include <type_safe/index.hpp>
+#include <type_safe/reference.hpp>
+
+namespace type_safe
+{
+/// A dynamic array of values of type `T` that are all in the same interval.
+///
+/// Unlike a [std::vector]() of [ts::bounded_type](),
+/// it stores the bounds only once for the entire array instead of in every element,
+/// which matters for [ts::constraints::dynamic_bound]():
+/// a dynamically bounded value is three times the size of the value itself.
+/// It hands out [ts::bounded_type]() values and [ts::constrained_ref]() references,
+/// which verify against a copy of the bounds.
+/// \notes Like [ts::constrained_type](), the elements are verified with the `Verifier`.
+template <typename T, bool LowerInclusive, bool UpperInclusive,
+          typename LowerBound = constraints::dynamic_bound,
+          typename UpperBound = constraints::dynamic_bound, typename Verifier = assertion_verifier>
+class bounded_array
+: constraints::bounded<T, LowerInclusive, UpperInclusive, LowerBound, UpperBound>
+{
+public:
+    using value_type = T;
+    using constraint_predicate =
+        constraints::bounded<T, LowerInclusive, UpperInclusive, LowerBound, UpperBound>;
+    using bounded_type_t =
+        bounded_type<T, LowerInclusive, UpperInclusive, LowerBound, UpperBound, Verifier>;
+    using reference = constrained_ref<T, constraint_predicate, Verifier>;
+    using iterator  = const T*;
+
+    //=== constructors ===//
+    /// \effects Creates an empty array with the given bounds.
+    /// \notes The default argument is only available for static bounds.
+    explicit bounded_array(constraint_predicate bounds = {})
+    : constraint_predicate(std::move(bounds))
+    {}
+
+    /// \effects Creates an array of `size` copies of `value` with the given bounds,
+    /// the `value` is verified once.
+    /// \throws Anything thrown by the `Verifier` if the `value` is invalid.
+    bounded_array(size_t size, const T& value, constraint_predicate bounds = {})
+    : constraint_predicate(std::move(bounds)),
+      values_(static_cast<std::size_t>(size), Verifier::verify(value, get_constraint()))
+    {}
+
+    /// \effects Creates an array of the `values` with the given bounds,
+    /// every value is verified.
+    /// \throws Anything thrown by the `Verifier` if a value is invalid.
+    explicit bounded_array(std::vector<T> values, constraint_predicate bounds = {})
+    : constraint_predicate(std::move(bounds)), values_(std::move(values))
+    {
+        using returns_ref = std::is_reference<decltype(
+            Verifier::verify(std::declval<T&>(), std::declval<const constraint_predicate&>()))>;
+        for (auto& value : values_)
+            verify_element(returns_ref{}, value);
+    }
+
+    /// \effects Creates an array of the `values` with the given bounds,
+    /// which are assumed to be valid.
+    /// They are only verified if [TYPE_SAFE_ENABLE_ASSERTIONS]() or
+    /// [TYPE_SAFE_ENABLE_AUDIT_CHECKS]() is `true`.
+    /// \requires Every value must be in the interval.
+    bounded_array(assume_valid_t, std::vector<T> values, constraint_predicate bounds = {})
+    : constraint_predicate(std::move(bounds)), values_(std::move(values))
+    {
+        DEBUG_ASSERT(std::all_of(values_.begin(), values_.end(), get_constraint()),
+                     detail::audit_handler{}, "values assumed to be valid are not");
+    }
+
+    //=== observers ===//
+    /// \returns The bounds of all elements.
+    const constraint_predicate& get_constraint() const noexcept
+    {
+        return *this;
+    }
+
+    /// \returns A [ts::verified_array_ref]() to the elements,
+    /// without verifying them again.
+    verified_array_ref<T, constraint_predicate> get_verified() const noexcept
+    {
+        return detail::make_verified(get_array(), get_constraint());
+    }
+
+    /// \returns An [ts::array_ref]() to the elements.
+    array_ref<const T> get_array() const noexcept
+    {
+        return array_ref<const T>(values_.data(), size());
+    }
+
+    /// \effects Moves the elements out,
+    /// they will not be checked further.
+    /// \returns An rvalue reference to the elements.
+    /// \notes After this function is called, the object must not be used anymore
+    /// except as target for assignment or in the destructor.
+    std::vector<T>&& release() TYPE_SAFE_RVALUE_REF noexcept
+    {
+        return std::move(values_);
+    }
+
+    //=== access ===//
+    /// \returns An iterator to the first element.
+    iterator begin() const noexcept
+    {
+        return values_.data();
+    }
+
+    /// \returns An iterator one past the last element.
+    iterator end() const noexcept
+    {
+        return values_.data() + values_.size();
+    }
+
+    /// \returns A pointer to the elements.
+    const T* data() const noexcept
+    {
+        return values_.data();
+    }
+
+    /// \returns Whether or not the array is empty.
+    bool empty() const noexcept
+    {
+        return values_.empty();
+    }
+
+    /// \returns The number of elements.
+    size_t size() const noexcept
+    {
+        return values_.size();
+    }
+
+    /// \returns A [ts::constrained_ref]() to the `i`th element,
+    /// which verifies modifications against the bounds.
+    /// \requires `i < size()`.
+    /// \group index
+    reference operator[](index_t i) noexcept
+    {
+        return reference(assume_valid, at(values_, i), get_constraint());
+    }
+
+    /// \returns A [ts::bounded_type]() with the value of the `i`th element and the bounds,
+    /// the value is not verified again.
+    /// \requires `i < size()`.
+    /// \group index
+    bounded_type_t operator[](index_t i) const
+    {
+        return bounded_type_t(assume_valid, at(values_, i), get_constraint());
+    }
+
+    //=== modifiers ===//
+    /// \effects Appends the `value` after verifying it.
+    /// \throws Anything thrown by the `Verifier` if the `value` is invalid.
+    /// \group push_back
+    void push_back(const T& value)
+    {
+        values_.push_back(Verifier::verify(value, get_constraint()));
+    }
+
+    /// \group push_back
+    void push_back(T&& value)
+    {
+        values_.push_back(Verifier::verify(std::move(value), get_constraint()));
+    }
+
+    /// \effects Removes the last element.
+    /// \requires The array must not be empty.
+    void pop_back() noexcept
+    {
+        DEBUG_ASSERT(!empty(), detail::precondition_error_handler{}, "empty array");
+        values_.pop_back();
+    }
+
+    /// \effects Removes all elements.
+    void clear() noexcept
+    {
+        values_.clear();
+    }
+
+    /// \effects Reserves memory for `size` elements.
+    void reserve(size_t size)
+    {
+        values_.reserve(static_cast<std::size_t>(size));
+    }
+
+private:
+    // the verifier returns its argument, assigning it would be a self-move
+    void verify_element(std::true_type, T& value) const
+    {
+        Verifier::verify(value, get_constraint());
+    }
+
+    // the verifier returns a new value, e.g. a clamped one
+    void verify_element(std::false_type, T& value) const
+    {
+        value = Verifier::verify(std::move(value), get_constraint());
+    }
+
+    std::vector<T> values_;
+};
+} // namespace type_safe
+
+#endif // TYPE_SAFE_BOUNDED_ARRAY_HPP_INCLUDED
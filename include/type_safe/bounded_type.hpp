@@ -5,6 +5,7 @@
 #ifndef TYPE_SAFE_BOUNDED_TYPE_HPP_INCLUDED
 #define TYPE_SAFE_BOUNDED_TYPE_HPP_INCLUDED
 
+#include <cstdint>
 #include <limits>
 #include <type_traits>
 
@@ -270,6 +271,43 @@ namespace constraints
 /// \exclude
 namespace detail
 {
+    // whether the lower bound of the outer interval is below the lower bound of the inner one
+    template <typename T, typename U>
+    constexpr bool lower_bound_within(const T& inner, bool inner_inclusive, const U& outer,
+                                      bool outer_inclusive) noexcept
+    {
+        return outer < inner || (outer == inner && (outer_inclusive || !inner_inclusive));
+    }
+
+    // whether the upper bound of the outer interval is above the upper bound of the inner one
+    template <typename T, typename U>
+    constexpr bool upper_bound_within(const T& inner, bool inner_inclusive, const U& outer,
+                                      bool outer_inclusive) noexcept
+    {
+        return inner < outer || (inner == outer && (outer_inclusive || !inner_inclusive));
+    }
+
+    template <bool IsStatic, class From, class To>
+    struct bounded_implies : std::false_type
+    {};
+
+    // the bounds are compared directly, like the value is compared with them
+    template <typename T, bool FromLowerInclusive, bool FromUpperInclusive,
+              typename FromLowerBound, typename FromUpperBound, bool ToLowerInclusive,
+              bool ToUpperInclusive, typename ToLowerBound, typename ToUpperBound>
+    struct bounded_implies<true,
+                           constraints::bounded<T, FromLowerInclusive, FromUpperInclusive,
+                                                FromLowerBound, FromUpperBound>,
+                           constraints::bounded<T, ToLowerInclusive, ToUpperInclusive,
+                                                ToLowerBound, ToUpperBound>>
+    : std::integral_constant<bool, lower_bound_within(FromLowerBound::value, FromLowerInclusive,
+                                                      ToLowerBound::value, ToLowerInclusive)
+                                       && upper_bound_within(FromUpperBound::value,
+                                                             FromUpperInclusive,
+                                                             ToUpperBound::value,
+                                                             ToUpperInclusive)>
+    {};
+
     template <typename T>
     struct valid_bound : std::integral_constant<bool, true || T::value>
     {};
@@ -350,6 +388,28 @@ namespace detail
                                    typename std::decay<U2>::type>::type;
 } // namespace detail
 
+/// Specialization of [ts::constraint_implies]() for [ts::constraints::bounded]().
+///
+/// It is `true` if both intervals have static bounds
+/// and the interval of `From` is contained in the interval of `To`, e.g. `[0, 10]` and `[0, 100]`.
+/// Then a [ts::bounded_type]() implicitly converts to the one with the wider interval,
+/// without verifying the value again.
+template <typename T, bool FromLowerInclusive, bool FromUpperInclusive, typename FromLowerBound,
+          typename FromUpperBound, bool ToLowerInclusive, bool ToUpperInclusive,
+          typename ToLowerBound, typename ToUpperBound>
+struct constraint_implies<
+    constraints::bounded<T, FromLowerInclusive, FromUpperInclusive, FromLowerBound, FromUpperBound>,
+    constraints::bounded<T, ToLowerInclusive, ToUpperInclusive, ToLowerBound, ToUpperBound>>
+: detail::bounded_implies<
+      !constraints::detail::is_dynamic<FromLowerBound>::value
+          && !constraints::detail::is_dynamic<FromUpperBound>::value
+          && !constraints::detail::is_dynamic<ToLowerBound>::value
+          && !constraints::detail::is_dynamic<ToUpperBound>::value,
+      constraints::bounded<T, FromLowerInclusive, FromUpperInclusive, FromLowerBound,
+                           FromUpperBound>,
+      constraints::bounded<T, ToLowerInclusive, ToUpperInclusive, ToLowerBound, ToUpperBound>>
+{};
+
 /// An alias for [ts::constrained_type]() that uses [ts::constraints::bounded]() as its
 /// `Constraint`. \notes This is some type where the values must be in a certain interval.
 template <typename T, bool LowerInclusive, bool UpperInclusive,
@@ -558,6 +618,169 @@ constexpr auto make_clamped(T&& value, U1&& lower, U2&& upper)
                        typename result_type::constraint_predicate(std::forward<U1>(lower),
                                                                   std::forward<U2>(upper)));
 }
+
+/// \exclude
+namespace detail
+{
+    template <std::uintmax_t Range>
+    using compact_bounded_storage = typename std::conditional<
+        Range <= 0xFFu, std::uint_least8_t,
+        typename std::conditional<
+            Range <= 0xFFFFu, std::uint_least16_t,
+            typename std::conditional<Range <= 0xFFFFFFFFu, std::uint_least32_t,
+                                      std::uintmax_t>::type>::type>::type;
+} // namespace detail
+
+/// A [ts::bounded_type]() with static bounds that only uses as much memory as the bounds require.
+///
+/// Instead of the value itself, it stores the offset from the smallest valid value
+/// in the smallest unsigned integer type that can hold the biggest offset,
+/// e.g. a single byte for the interval `[1000, 1200]`.
+/// The value is converted back on every access,
+/// so the accessors return it by value instead of by reference.
+/// Otherwise, it has the same interface as [ts::bounded_type](),
+/// except for `modify()`, `operator->` and `release()`,
+/// and it converts from and to the corresponding [ts::bounded_type]().
+/// \requires `T` must be an integral type and both bounds must be static,
+/// i.e. not [ts::constraints::dynamic_bound]().
+/// \notes Use it for arrays of many bounded values, where the memory use matters,
+/// otherwise [ts::bounded_type]() is more efficient.
+template <typename T, bool LowerInclusive, bool UpperInclusive, typename LowerBound,
+          typename UpperBound, typename Verifier = assertion_verifier>
+class compact_bounded_type
+{
+    static_assert(std::is_integral<T>::value, "T must be an integral type");
+    static_assert(!constraints::detail::is_dynamic<LowerBound>::value
+                      && !constraints::detail::is_dynamic<UpperBound>::value,
+                  "compact_bounded_type requires static bounds");
+
+    static constexpr T min_value = T(LowerInclusive ? LowerBound::value : LowerBound::value + 1);
+    static constexpr T max_value = T(UpperInclusive ? UpperBound::value : UpperBound::value - 1);
+    static_assert(min_value <= max_value, "empty interval");
+
+public:
+    using value_type           = T;
+    using constraint_predicate = constraints::bounded<T, LowerInclusive, UpperInclusive,
+                                                      LowerBound, UpperBound>;
+    using bounded_type_t = bounded_type<T, LowerInclusive, UpperInclusive, LowerBound, UpperBound,
+                                        Verifier>;
+    /// The unsigned integer type used to store the value.
+    using storage_type
+        = detail::compact_bounded_storage<static_cast<std::uintmax_t>(max_value)
+                                          - static_cast<std::uintmax_t>(min_value)>;
+
+    /// \effects Creates it giving it a valid `value`, which will be verified.
+    /// \throws Anything thrown by the `Verifier` if the `value` is invalid.
+    explicit constexpr compact_bounded_type(const value_type& value, constraint_predicate = {})
+    : offset_(encode(Verifier::verify(value, constraint_predicate{})))
+    {}
+
+    /// \effects Creates it from the value of the uncompressed `bounded`.
+    constexpr compact_bounded_type(const bounded_type_t& bounded) noexcept
+    : offset_(encode(bounded.get_value()))
+    {}
+
+    /// \effects Same as `*this = compact_bounded_type(value)`.
+    /// \throws Anything thrown by the `Verifier` if the `value` is invalid.
+    /// If the `value` is invalid, nothing will be changed.
+    TYPE_SAFE_CONSTEXPR14 compact_bounded_type& operator=(const value_type& value)
+    {
+        offset_ = compact_bounded_type(value).offset_;
+        return *this;
+    }
+
+    /// \returns The uncompressed [ts::bounded_type]() with the same value.
+    constexpr operator bounded_type_t() const noexcept
+    {
+        return bounded_type_t(get_value());
+    }
+
+    /// Dereference operator.
+    /// \returns The stored value.
+    constexpr value_type operator*() const noexcept
+    {
+        return get_value();
+    }
+
+    /// \returns The stored value.
+    constexpr value_type get_value() const noexcept
+    {
+        return value_type(static_cast<std::uintmax_t>(min_value) + offset_);
+    }
+
+    /// \returns The predicate that determines validity.
+    constexpr constraint_predicate get_constraint() const noexcept
+    {
+        return {};
+    }
+
+    /// \returns The stored offset from the smallest valid value.
+    constexpr storage_type get_offset() const noexcept
+    {
+        return offset_;
+    }
+
+    /// \returns The result of the comparison of the stored values.
+    /// \group compact_comp
+    friend constexpr bool operator==(const compact_bounded_type& a,
+                                     const compact_bounded_type& b) noexcept
+    {
+        return a.offset_ == b.offset_;
+    }
+
+    /// \group compact_comp
+    friend constexpr bool operator!=(const compact_bounded_type& a,
+                                     const compact_bounded_type& b) noexcept
+    {
+        return a.offset_ != b.offset_;
+    }
+
+    /// \group compact_comp
+    friend constexpr bool operator<(const compact_bounded_type& a,
+                                    const compact_bounded_type& b) noexcept
+    {
+        return a.offset_ < b.offset_;
+    }
+
+    /// \group compact_comp
+    friend constexpr bool operator<=(const compact_bounded_type& a,
+                                     const compact_bounded_type& b) noexcept
+    {
+        return a.offset_ <= b.offset_;
+    }
+
+    /// \group compact_comp
+    friend constexpr bool operator>(const compact_bounded_type& a,
+                                    const compact_bounded_type& b) noexcept
+    {
+        return a.offset_ > b.offset_;
+    }
+
+    /// \group compact_comp
+    friend constexpr bool operator>=(const compact_bounded_type& a,
+                                     const compact_bounded_type& b) noexcept
+    {
+        return a.offset_ >= b.offset_;
+    }
+
+private:
+    static constexpr storage_type encode(const value_type& value) noexcept
+    {
+        return storage_type(static_cast<std::uintmax_t>(value)
+                            - static_cast<std::uintmax_t>(min_value));
+    }
+
+    storage_type offset_;
+};
+
+template <typename T, bool LowerInclusive, bool UpperInclusive, typename LowerBound,
+          typename UpperBound, typename Verifier>
+constexpr T compact_bounded_type<T, LowerInclusive, UpperInclusive, LowerBound, UpperBound,
+                                 Verifier>::min_value;
+template <typename T, bool LowerInclusive, bool UpperInclusive, typename LowerBound,
+          typename UpperBound, typename Verifier>
+constexpr T compact_bounded_type<T, LowerInclusive, UpperInclusive, LowerBound, UpperBound,
+                                 Verifier>::max_value;
 } // namespace type_safe
 
 #endif // TYPE_SAFE_BOUNDED_TYPE_HPP_INCLUDED
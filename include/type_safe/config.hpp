@@ -22,6 +22,22 @@
 #    define TYPE_SAFE_ENABLE_PRECONDITION_CHECKS 1
 #endif
 
+#ifndef TYPE_SAFE_ENABLE_AUDIT_CHECKS
+/// Controls whether values created with [ts::assume_valid]() are checked by a debug assertion,
+/// even if assertions are disabled.
+///
+/// It is disabled by default.
+#    define TYPE_SAFE_ENABLE_AUDIT_CHECKS 0
+#endif
+
+#ifndef TYPE_SAFE_SAMPLING_RATE
+/// Controls how often the [ts::sampling_verifier]() verifies a value.
+///
+/// It verifies one in `TYPE_SAFE_SAMPLING_RATE` values, the default is `64`.
+/// A power of two is recommended, it must not be `0`.
+#    define TYPE_SAFE_SAMPLING_RATE 64
+#endif
+
 #ifndef TYPE_SAFE_ENABLE_WRAPPER
 /// Controls whether the typedefs in [types.hpp]() use the type safe wrapper types.
 ///
@@ -0,0 +1,211 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_CONSTRAINED_RANGE_HPP_INCLUDED
+#define TYPE_SAFE_CONSTRAINED_RANGE_HPP_INCLUDED
+
+#include <type_traits>
+
+#include <type_safe/bounded_type.hpp>
+#include <type_safe/constrained_type.hpp>
+#include <type_safe/index.hpp>
+#include <type_safe/optional.hpp>
+#include <type_safe/reference.hpp>
+
+namespace type_safe
+{
+template <typename T, class Constraint>
+class verified_array_ref;
+
+/// \exclude
+namespace detail
+{
+    // number of elements checked without an early exit,
+    // so the checks of a block can be vectorized
+    constexpr std::size_t verify_block_size = 64u;
+
+    template <typename T, class Constraint>
+    std::size_t find_invalid(const T* data, std::size_t size, const Constraint& constraint)
+    {
+        // local copy, so the compiler knows that the bounds are not modified
+        auto c = constraint;
+
+        std::size_t begin = 0u;
+        for (; size - begin >= verify_block_size; begin += verify_block_size)
+        {
+            auto invalid = 0u;
+            for (auto i = begin; i != begin + verify_block_size; ++i)
+                invalid |= unsigned(!c(data[i]));
+            if (invalid)
+                break;
+        }
+
+        // find the exact element in the block with the invalid element or the remainder
+        for (; begin != size; ++begin)
+            if (!c(data[begin]))
+                return begin;
+        return size;
+    }
+
+    template <typename T, class Constraint>
+    verified_array_ref<typename std::remove_const<T>::type, Constraint> make_verified(
+        const array_ref<T>& range, const Constraint& c) noexcept
+    {
+        return verified_array_ref<typename std::remove_const<T>::type, Constraint>(range.data(),
+                                                                                  range.size(), c);
+    }
+} // namespace detail
+
+/// A reference to an array where every element fulfills the predicate `Constraint`.
+///
+/// It is the result of [ts::verify_range](), [ts::sanitize_range]() and [ts::clamp_range](),
+/// which verify all elements at once.
+/// It gives `const` access to the elements without checking them again.
+/// \notes Like [ts::array_ref]() it does not own the elements,
+/// the array must not be modified while it is in use.
+template <typename T, class Constraint>
+class verified_array_ref : Constraint
+{
+public:
+    using value_type           = T;
+    using constraint_predicate = Constraint;
+    using iterator             = const T*;
+
+    /// \returns The array of the elements.
+    array_ref<const T> get_array() const noexcept
+    {
+        return array_ref<const T>(data_, size_);
+    }
+
+    /// \returns The predicate all elements fulfill.
+    const constraint_predicate& get_constraint() const noexcept
+    {
+        return *this;
+    }
+
+    /// \returns An iterator to the beginning of the array.
+    iterator begin() const noexcept
+    {
+        return data_;
+    }
+
+    /// \returns An iterator one past the last element of the array.
+    iterator end() const noexcept
+    {
+        return data_ + static_cast<std::size_t>(size_);
+    }
+
+    /// \returns A pointer to the beginning of the array.
+    const T* data() const noexcept
+    {
+        return data_;
+    }
+
+    /// \returns The number of elements in the array.
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    /// \returns A `const` reference to the `i`th element of the array,
+    /// which fulfills the predicate.
+    /// \requires `i < size()`.
+    const T& operator[](index_t i) const noexcept
+    {
+        DEBUG_ASSERT(static_cast<size_t&>(i) < size_, detail::precondition_error_handler{},
+                     "out of bounds array access");
+        return at(data_, i);
+    }
+
+private:
+    verified_array_ref(const T* data, size_t size, const Constraint& c) noexcept
+    : Constraint(c), data_(data), size_(size)
+    {}
+
+    const T* data_;
+    size_t   size_;
+
+    template <typename U, class C>
+    friend verified_array_ref<typename std::remove_const<U>::type, C> detail::make_verified(
+        const array_ref<U>& range, const C& c) noexcept;
+};
+
+/// \returns The index of the first element of `range` that does not fulfill the predicate
+/// `constraint`, or `range.size()` if all elements fulfill it.
+/// \notes The predicate is evaluated for blocks of elements without an early exit,
+/// which allows vectorizing simple predicates such as the interval constraints of
+/// [ts::bounded_type]() or [ts::constraints::non_null]().
+template <typename T, class Constraint>
+index_t find_invalid(array_ref<T> range, const Constraint& constraint)
+{
+    return index_t(detail::find_invalid(range.data(), static_cast<std::size_t>(range.size()),
+                                        constraint));
+}
+
+/// \returns A [ts::verified_array_ref]() to `range`,
+/// or [ts::nullopt]() if an element does not fulfill the predicate `constraint`.
+/// \notes Use [ts::find_invalid]() to get the index of the invalid element.
+template <typename T, class Constraint>
+optional<verified_array_ref<typename std::remove_const<T>::type, Constraint>> verify_range(
+    array_ref<T> range, const Constraint& constraint)
+{
+    if (find_invalid(range, constraint) != index_t(static_cast<std::size_t>(range.size())))
+        return nullopt;
+    return detail::make_verified(range, constraint);
+}
+
+/// \returns A [ts::verified_array_ref]() to `range`.
+/// \throws A [ts::constrain_error]() if an element does not fulfill the predicate `constraint`.
+/// \notes This is meant for sanitizing user input,
+/// using a recoverable error handling strategy.
+template <typename T, class Constraint>
+verified_array_ref<typename std::remove_const<T>::type, Constraint> sanitize_range(
+    array_ref<T> range, const Constraint& constraint)
+{
+    if (find_invalid(range, constraint) != index_t(static_cast<std::size_t>(range.size())))
+        TYPE_SAFE_THROW(constrain_error{});
+    return detail::make_verified(range, constraint);
+}
+
+/// \effects Clamps every element of `range` using the [ts::clamping_verifier](),
+/// i.e. replaces it with the closer bound if it is not valid.
+/// \returns A [ts::verified_array_ref]() to `range`.
+/// \notes The clamping does not branch,
+/// so it can be vectorized to min/max instructions for arithmetic types.
+/// \group clamp_range
+template <typename T, typename U, typename LowerBound, typename UpperBound>
+verified_array_ref<T, constraints::closed_interval<U, LowerBound, UpperBound>> clamp_range(
+    array_ref<T> range, const constraints::closed_interval<U, LowerBound, UpperBound>& interval)
+{
+    // local copy, so the compiler knows that the bounds are not modified by the loop
+    auto local = interval;
+    for (auto& elem : range)
+        elem = clamp(local, elem);
+    return detail::make_verified(range, interval);
+}
+
+/// \group clamp_range
+template <typename T, typename U, typename Bound>
+verified_array_ref<T, constraints::less_equal<U, Bound>> clamp_range(
+    array_ref<T> range, const constraints::less_equal<U, Bound>& bound)
+{
+    auto local = bound;
+    for (auto& elem : range)
+        elem = clamping_verifier::verify(elem, local);
+    return detail::make_verified(range, bound);
+}
+
+/// \group clamp_range
+template <typename T, typename U, typename Bound>
+verified_array_ref<T, constraints::greater_equal<U, Bound>> clamp_range(
+    array_ref<T> range, const constraints::greater_equal<U, Bound>& bound)
+{
+    auto local = bound;
+    for (auto& elem : range)
+        elem = clamping_verifier::verify(elem, local);
+    return detail::make_verified(range, bound);
+}
+} // namespace type_safe
+
+#endif // TYPE_SAFE_CONSTRAINED_RANGE_HPP_INCLUDED
@@ -78,8 +78,67 @@ namespace detail
     template <class Constraint, typename T>
     struct is_valid : decltype(verify_static_constrained<Constraint, T>(0))
     {};
+
+    template <class Verifier>
+    auto verify_on_access(int) -> std::integral_constant<bool, Verifier::verify_on_access>;
+
+    template <class Verifier>
+    auto verify_on_access(char) -> std::true_type;
+
+    // verifies the stored value on access, unless the Verifier opts out
+    template <class Verifier, typename Value, typename Predicate>
+    constexpr const Value& verify_access(std::true_type, const Value& val, const Predicate& p)
+    {
+        return Verifier::verify(val, p), val;
+    }
+
+    template <class Verifier, typename Value, typename Predicate>
+    constexpr const Value& verify_access(std::false_type, const Value& val, const Predicate&)
+    {
+        return val;
+    }
+
+    // checks a value that is assumed to be valid, only if requested,
+    // the Verifier isn't used as it could change the value instead of reporting it
+    template <typename Value, typename Predicate>
+    constexpr const Value& verify_assumed(const Value& val, const Predicate& p)
+    {
+#if TYPE_SAFE_ENABLE_ASSERTIONS || TYPE_SAFE_ENABLE_AUDIT_CHECKS
+        return p(val) ? val
+                      : (DEBUG_UNREACHABLE(detail::audit_handler{},
+                                           "value assumed to be valid is not"),
+                         val);
+#else
+        return (void)p, val;
+#endif
+    }
 } // namespace detail
 
+/// Tag type to create a [ts::constrained_type]() from a value that is known to be valid.
+struct assume_valid_t
+{
+    constexpr assume_valid_t() {}
+};
+
+/// Tag object of type [ts::assume_valid_t]().
+///
+/// Pass it to the constructor of [ts::constrained_type]() to skip the verification,
+/// e.g. for values read back from a trusted source.
+/// The `Verifier` is not invoked, but if [TYPE_SAFE_ENABLE_ASSERTIONS]() or
+/// [TYPE_SAFE_ENABLE_AUDIT_CHECKS]() is `true`, a debug assertion checks the predicate.
+constexpr assume_valid_t assume_valid;
+
+/// Whether or not every value that fulfills the predicate `From`
+/// also fulfills the predicate `To`.
+///
+/// If it is `true`, a [ts::constrained_type]() with `From` implicitly converts to one with `To`,
+/// without verifying the value again.
+/// It is `false` by default, specialize it for your own constraints.
+/// \requires If specialized to be `true`, `To` must be default constructible.
+template <class From, class To>
+struct constraint_implies : std::false_type
+{};
+
 template <typename T, class Constraint, class Verifier>
 class constrained_modifier;
 
@@ -95,7 +154,9 @@ class constrained_modifier;
 /// operation throws, and `Verifier` must provide a `static` function `[const] T[&] verify(const T&,
 /// const Predicate&)`. The return value is stored and it must always fulfill the predicate. It also
 /// requires that no `const` operation on `T` may modify it in a way that the predicate isn't
-/// fulfilled anymore. \notes Additional requirements of the `Constraint` depend on the `Verifier`
+/// fulfilled anymore. If [TYPE_SAFE_ENABLE_ASSERTIONS]() is `true`, the value is verified again on
+/// every access, unless `Verifier` has a `static constexpr bool verify_on_access = false`. \notes
+/// Additional requirements of the `Constraint` depend on the `Verifier`
 /// used. If not stated otherwise, a `Verifier` in this library requires that the `Constraint` is a
 /// `Predicate` for `T`.
 template <typename T, typename Constraint, class Verifier = assertion_verifier>
@@ -125,6 +186,39 @@ public:
     : Constraint(std::move(predicate)), value_(Verifier::verify(std::move(value), get_constraint()))
     {}
 
+    /// \effects Creates it giving it a `value` that is assumed to be valid, and a `predicate`.
+    /// The `value` will be copied(1)/moved(2) without invoking the `Verifier`.
+    /// Only if [TYPE_SAFE_ENABLE_ASSERTIONS]() or [TYPE_SAFE_ENABLE_AUDIT_CHECKS]() is `true`,
+    /// a debug assertion checks that it fulfills the predicate.
+    /// \throws Anything thrown by the copy(1)/move(2) constructor of `value_type`.
+    /// \requires The `value` must fulfill the predicate.
+    /// \group assume_valid_ctor
+    constexpr constrained_type(assume_valid_t, const value_type& value,
+                               constraint_predicate predicate = {})
+    : Constraint(std::move(predicate)),
+      value_(detail::verify_assumed(value, get_constraint()))
+    {}
+
+    /// \group assume_valid_ctor
+    constexpr constrained_type(assume_valid_t, value_type&& value,
+                               constraint_predicate predicate = {})
+    : Constraint(std::move(predicate)),
+      value_((detail::verify_assumed(value, get_constraint()), std::move(value)))
+    {}
+
+    /// \effects Copies the value of `other`, which is valid as its predicate implies this one.
+    /// The `Verifier` is not invoked, but if [TYPE_SAFE_ENABLE_ASSERTIONS]() or
+    /// [TYPE_SAFE_ENABLE_AUDIT_CHECKS]() is `true`, a debug assertion checks the predicate.
+    /// \throws Anything thrown by the copy constructor of `value_type`.
+    /// \notes This constructor does not participate in overload resolution,
+    /// unless [ts::constraint_implies<OtherConstraint, Constraint>]() is `true`.
+    template <class OtherConstraint, class OtherVerifier,
+              typename = typename std::enable_if<
+                  constraint_implies<OtherConstraint, Constraint>::value>::type>
+    constexpr constrained_type(const constrained_type<T, OtherConstraint, OtherVerifier>& other)
+    : Constraint(), value_(detail::verify_assumed(other.get_value(), get_constraint()))
+    {}
+
     /// \exclude
     template <typename U,
               typename
@@ -150,7 +244,8 @@ public:
     TYPE_SAFE_CONSTEXPR14 constrained_type& operator=(const value_type& other)
     {
         constrained_type tmp(other, get_constraint());
-        value_ = std::move(tmp).release();
+        // tmp has just been verified, so don't use release()
+        value_ = std::move(tmp.value_);
         return *this;
     }
 
@@ -160,7 +255,7 @@ public:
             Verifier::verify(std::move(other), std::declval<Constraint&>())))
     {
         constrained_type tmp(std::move(other), get_constraint());
-        value_ = std::move(tmp).release();
+        value_ = std::move(tmp.value_);
         return *this;
     }
 
@@ -173,25 +268,23 @@ public:
     /// \effects Copies the value and predicate from `other`.
     /// \throws Anything thrown by the copy assignment operator of `value_type`.
     /// \requires `Constraint` must be copyable.
+    /// \notes The value of `other` is verified once, by the copy constructor.
     TYPE_SAFE_CONSTEXPR14 constrained_type& operator=(const constrained_type& other)
     {
         constrained_type tmp(other);
-        swap(*this, tmp);
+        swap_unverified(tmp);
         return *this;
     }
 
     /// \effects Swaps the value and predicate of a `a` and `b`.
     /// \throws Anything thrown by the swap function of `value_type`.
     /// \requires `Constraint` must be swappable.
+    /// \notes The values are not verified,
+    /// exchanging them together with their predicates does not change their validity.
     friend TYPE_SAFE_CONSTEXPR14 void swap(constrained_type& a, constrained_type& b) noexcept(
         detail::is_nothrow_swappable<value_type>::value)
     {
-        a.debug_verify();
-        b.debug_verify();
-
-        using std::swap;
-        swap(a.value_, b.value_);
-        swap(static_cast<Constraint&>(a), static_cast<Constraint&>(b));
+        a.swap_unverified(b);
     }
 
     /// \returns A proxy object to provide verified write-access to the stored value.
@@ -245,7 +338,8 @@ private:
     constexpr const value_type& debug_verify() const noexcept
     {
 #if TYPE_SAFE_ENABLE_ASSERTIONS
-        return Verifier::verify(value_, get_constraint()), value_;
+        return detail::verify_access<Verifier>(decltype(detail::verify_on_access<Verifier>(0)){},
+                                                value_, get_constraint());
 #else
         return value_;
 #endif
@@ -256,6 +350,14 @@ private:
         return value_;
     }
 
+    TYPE_SAFE_CONSTEXPR14 void swap_unverified(constrained_type& other) noexcept(
+        detail::is_nothrow_swappable<value_type>::value)
+    {
+        using std::swap;
+        swap(value_, other.value_);
+        swap(static_cast<Constraint&>(*this), static_cast<Constraint&>(other));
+    }
+
     value_type value_;
     friend constrained_modifier<T, Constraint, Verifier>;
 };
@@ -274,7 +376,16 @@ public:
 
     /// \effects Binds the reference to the given object.
     explicit constexpr constrained_type(T& value, constraint_predicate predicate = {})
-    : Constraint(std::move(predicate)), ref_(&Verifier::verify(value, get_constraint()))
+    : Constraint(std::move(predicate)), ref_((Verifier::verify(value, get_constraint()), &value))
+    {}
+
+    /// \effects Binds the reference to the given object, which is assumed to be valid.
+    /// The `Verifier` is not invoked, but if [TYPE_SAFE_ENABLE_ASSERTIONS]() or
+    /// [TYPE_SAFE_ENABLE_AUDIT_CHECKS]() is `true`, a debug assertion checks the predicate.
+    /// \requires The `value` must fulfill the predicate.
+    constexpr constrained_type(assume_valid_t, T& value, constraint_predicate predicate = {})
+    : Constraint(std::move(predicate)),
+      ref_((detail::verify_assumed(value, get_constraint()), &value))
     {}
 
     /// \exclude
@@ -323,7 +434,8 @@ private:
     constexpr const value_type& debug_verify() const noexcept
     {
 #if TYPE_SAFE_ENABLE_ASSERTIONS
-        return Verifier::verify(*ref_, get_constraint());
+        return detail::verify_access<Verifier>(decltype(detail::verify_on_access<Verifier>(0)){},
+                                                *ref_, get_constraint());
 #else
         return *ref_;
 #endif
@@ -616,6 +728,12 @@ namespace constraints
     struct owner
     {};
 } // namespace constraints
+
+/// An alias for [ts::tagged_type]() that marks an owning pointer,
+/// using [ts::constraints::owner]().
+/// \notes `Pointer` is the pointer type, i.e. `owner<int*>`, like GSL's `owner`.
+template <typename Pointer>
+using owner = tagged_type<Pointer, constraints::owner>;
 } // namespace type_safe
 
 #endif // TYPE_SAFE_CONSTRAINED_TYPE_HPP_INCLUDED
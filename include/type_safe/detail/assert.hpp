@@ -22,6 +22,12 @@ namespace detail
       debug_assert::default_handler
     {};
 
+    // checks values that are assumed to be valid
+    struct audit_handler
+    : debug_assert::set_level<TYPE_SAFE_ENABLE_ASSERTIONS || TYPE_SAFE_ENABLE_AUDIT_CHECKS>,
+      debug_assert::default_handler
+    {};
+
     inline void on_disabled_exception() noexcept
     {
         struct handler : debug_assert::set_level<1>, debug_assert::default_handler
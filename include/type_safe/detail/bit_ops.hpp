@@ -0,0 +1,106 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_DETAIL_BIT_OPS_HPP_INCLUDED
+#define TYPE_SAFE_DETAIL_BIT_OPS_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#    include <intrin.h>
+#endif
+
+#if defined(__BMI2__) && (defined(__x86_64__) || defined(_M_X64))
+#    include <immintrin.h>
+#    define TYPE_SAFE_DETAIL_HAS_PDEP 1
+#else
+#    define TYPE_SAFE_DETAIL_HAS_PDEP 0
+#endif
+
+namespace type_safe
+{
+namespace detail
+{
+    // number of trailing zeros, requires x != 0
+    inline std::size_t count_trailing_zeros(std::uint_least64_t x) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_ctzll(x));
+#elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long result;
+        _BitScanForward64(&result, x);
+        return result;
+#else
+        std::size_t result = 0u;
+        for (; (x & 1u) == 0u; x >>= 1u)
+            ++result;
+        return result;
+#endif
+    }
+
+    // number of bits set
+    inline std::size_t popcount(std::uint_least64_t x) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_popcountll(x));
+#elif defined(_MSC_VER) && defined(_M_X64)
+        return static_cast<std::size_t>(__popcnt64(x));
+#else
+        std::size_t result = 0u;
+        for (; x != 0u; x &= x - 1u)
+            ++result;
+        return result;
+#endif
+    }
+
+    // deposits the low bits of x into the positions of the bits set in mask, i.e. pdep
+    inline std::uint_least64_t deposit_bits(std::uint_least64_t x,
+                                            std::uint_least64_t mask) noexcept
+    {
+#if TYPE_SAFE_DETAIL_HAS_PDEP
+        return _pdep_u64(x, mask);
+#else
+        std::uint_least64_t result = 0u;
+        for (std::uint_least64_t bit = 1u; mask != 0u; bit <<= 1u)
+        {
+            if (x & bit)
+                result |= mask & (~mask + 1u); // lowest bit set in mask
+            mask &= mask - 1u;
+        }
+        return result;
+#endif
+    }
+
+    // full 128bit product of a and b, returns the high half and stores the low half in low
+    inline std::uint_least64_t multiply_wide(std::uint_least64_t a, std::uint_least64_t b,
+                                             std::uint_least64_t& low) noexcept
+    {
+#if defined(__SIZEOF_INT128__)
+        __extension__ using uint128 = unsigned __int128;
+        auto product                = uint128(a) * b;
+        low                         = static_cast<std::uint_least64_t>(product);
+        return static_cast<std::uint_least64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned __int64 high;
+        low = _umul128(a, b, &high);
+        return high;
+#else
+        auto a_low = a & 0xFFFFFFFFu, a_high = a >> 32;
+        auto b_low = b & 0xFFFFFFFFu, b_high = b >> 32;
+
+        auto low_low   = a_low * b_low;
+        auto high_low  = a_high * b_low;
+        auto low_high  = a_low * b_high;
+        auto high_high = a_high * b_high;
+
+        auto middle = (low_low >> 32) + (high_low & 0xFFFFFFFFu) + low_high;
+        low         = (middle << 32) | (low_low & 0xFFFFFFFFu);
+        return high_high + (high_low >> 32) + (middle >> 32);
+#endif
+    }
+} // namespace detail
+} // namespace type_safe
+
+#endif // TYPE_SAFE_DETAIL_BIT_OPS_HPP_INCLUDED
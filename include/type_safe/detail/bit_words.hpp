@@ -0,0 +1,76 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_DETAIL_BIT_WORDS_HPP_INCLUDED
+#define TYPE_SAFE_DETAIL_BIT_WORDS_HPP_INCLUDED
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+
+#include <type_safe/detail/bit_ops.hpp>
+
+namespace type_safe
+{
+namespace detail
+{
+    // bits stored in an array of words, bit i is bit i % bit_word_bits of word i / bit_word_bits,
+    // the bits after the last one must be zero
+    using bit_word = std::uint_least64_t;
+
+    constexpr std::size_t bit_word_bits = sizeof(bit_word) * CHAR_BIT;
+
+    // number of words required to store size bits
+    constexpr std::size_t bit_word_count(std::size_t size) noexcept
+    {
+        return (size + bit_word_bits - 1u) / bit_word_bits;
+    }
+
+    // the bits of the last word that are used when storing size bits
+    constexpr bit_word last_bit_word_mask(std::size_t size) noexcept
+    {
+        return size % bit_word_bits == 0u
+                   ? bit_word(~bit_word(0u))
+                   : bit_word(bit_word(~bit_word(0u)) >> (bit_word_bits - size % bit_word_bits));
+    }
+
+    // number of bits set in the words
+    inline std::size_t count_set_bits(const bit_word* words, std::size_t count) noexcept
+    {
+        std::size_t result = 0u;
+        for (std::size_t i = 0u; i != count; ++i)
+            result += popcount(words[i]);
+        return result;
+    }
+
+    // index of the first bit set whose index is >= pos, or size if there is none
+    inline std::size_t find_set_bit(const bit_word* words, std::size_t size,
+                                    std::size_t pos) noexcept
+    {
+        if (pos >= size)
+            return size;
+
+        auto cur_word = pos / bit_word_bits;
+        auto rest     = bit_word(words[cur_word] >> (pos % bit_word_bits));
+        if (rest != bit_word(0u))
+            return pos + count_trailing_zeros(rest);
+
+        for (++cur_word; cur_word != bit_word_count(size); ++cur_word)
+            if (words[cur_word] != bit_word(0u))
+                return cur_word * bit_word_bits + count_trailing_zeros(words[cur_word]);
+        return size;
+    }
+
+    // invokes f with the index of every bit set, in increasing order
+    template <typename Func>
+    void for_each_set_bit(const bit_word* words, std::size_t count, Func& f)
+    {
+        for (std::size_t i = 0u; i != count; ++i)
+            for (auto rest = words[i]; rest != bit_word(0u); rest &= bit_word(rest - 1u))
+                f(i * bit_word_bits + count_trailing_zeros(rest));
+    }
+} // namespace detail
+} // namespace type_safe
+
+#endif // TYPE_SAFE_DETAIL_BIT_WORDS_HPP_INCLUDED
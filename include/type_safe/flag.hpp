@@ -49,6 +49,7 @@ constexpr bool operator==(flag lhs, T rhs) noexcept;
 /// ```
 /// \notes It is named `flag` for consistency with [std::atomic_flag](),
 /// even though this one can provide an extended interface as it is not atomic.
+/// Use [ts::atomic_flag]() if you need an atomic one.
 /// `flag` has nothing to do with [ts::flag_set]().
 /// \module types
 class flag
@@ -7,8 +7,11 @@
 
 #include <climits>
 #include <cstdint>
+#include <iterator>
 #include <type_traits>
 
+#include <type_safe/detail/bit_ops.hpp>
+#include <type_safe/detail/bit_words.hpp>
 #include <type_safe/flag.hpp>
 #include <type_safe/types.hpp>
 
@@ -52,6 +55,9 @@ namespace detail
 ///
 /// \requires For all specializations the enum must be contiguous starting at `0`,
 /// simply don't set an explicit value to the enumerators.
+/// \notes There is no limit on the number of enumerators.
+/// Flags that fit into a single integer are stored as such,
+/// bigger ones use an array of integers.
 template <typename Enum>
 struct flag_set_traits : detail::is_flag_set<Enum>
 {
@@ -61,6 +67,23 @@ struct flag_set_traits : detail::is_flag_set<Enum>
     }
 };
 
+/// Traits for the names of the enumerators of a flag.
+///
+/// They are used by the formatting and parsing functions of `type_safe/flag_set_format.hpp`.
+/// To enable them for a flag, specialize the traits and provide the following interface:
+/// * Inherit from [std::true_type]().
+/// * `static constexpr const char* name(std::size_t i) noexcept` that returns the name of the
+/// enumerator with value `i`, for all `i < flag_set_traits<Enum>::size()`.
+///
+/// The default specialization inherits from [std::false_type]().
+///
+/// \requires The names must be unique, non-empty and must not contain `|`.
+/// \notes If `name()` is a constant expression and `constexpr` is the C++14 version,
+/// the hash table used for parsing is computed at compile-time.
+template <typename Enum>
+struct flag_set_names : std::false_type
+{};
+
 /// Tag type to mark a [ts::flag_set]() without any flags set.
 struct noflag_t
 {
@@ -76,8 +99,7 @@ namespace detail
     template <std::size_t Size, typename = void>
     struct select_flag_set_int
     {
-        static_assert(Size != 0u,
-                      "number of bits not supported, complain loud enough so I'll do it");
+        // more bits than the biggest integer, flag_set_bits<Size, false> stores an array of words
     };
 
 /// \exclude
@@ -95,23 +117,317 @@ namespace detail
 
 #undef TYPE_SAFE_DETAIL_SELECT
 
+    template <std::size_t Size, typename = void>
+    struct has_flag_set_int : std::false_type
+    {};
+
+    template <std::size_t Size>
+    struct has_flag_set_int<Size, decltype(
+                                      static_cast<void>(typename select_flag_set_int<Size>::type()))>
+    : std::true_type
+    {};
+
+    // bits of a flag set that fit into a single integer
+    template <std::size_t Size, bool SingleInt = has_flag_set_int<Size>::value>
+    class flag_set_bits
+    {
+        static_assert(Size != 0u, "flag set must not be empty");
+
+    public:
+        using int_type = typename select_flag_set_int<Size>::type;
+
+        static constexpr flag_set_bits all_set() noexcept
+        {
+            return flag_set_bits(
+                int_type(int_type(~int_type(0u)) >> (sizeof(int_type) * CHAR_BIT - Size)));
+        }
+        static constexpr flag_set_bits none_set() noexcept
+        {
+            return flag_set_bits(int_type(0u));
+        }
+        static constexpr flag_set_bits single(std::size_t i) noexcept
+        {
+            return flag_set_bits(int_type(int_type(1u) << i));
+        }
+        static constexpr flag_set_bits from_int(int_type bits) noexcept
+        {
+            return flag_set_bits(bits);
+        }
+
+        static constexpr flag_set_bits filled(bool value) noexcept
+        {
+            return flag_set_bits(int_type(all_set().bits_ & int_type(int_type(0u) - value)));
+        }
+
+        constexpr flag_set_bits set(std::size_t i) const noexcept
+        {
+            return flag_set_bits(int_type(bits_ | single(i).bits_));
+        }
+        constexpr flag_set_bits set(std::size_t i, bool value) const noexcept
+        {
+            return flag_set_bits(int_type((bits_ & ~single(i).bits_) | (int_type(value) << i)));
+        }
+        constexpr flag_set_bits reset(std::size_t i) const noexcept
+        {
+            return flag_set_bits(int_type(bits_ & ~single(i).bits_));
+        }
+        constexpr flag_set_bits toggle(std::size_t i) const noexcept
+        {
+            return flag_set_bits(int_type(bits_ ^ single(i).bits_));
+        }
+        constexpr bool is_set(std::size_t i) const noexcept
+        {
+            return (bits_ & single(i).bits_) != int_type(0u);
+        }
+
+        constexpr flag_set_bits toggle_all() const noexcept
+        {
+            return flag_set_bits(int_type(bits_ ^ all_set().bits_));
+        }
+
+        constexpr flag_set_bits bitwise_or(const flag_set_bits& other) const noexcept
+        {
+            return flag_set_bits(int_type(bits_ | other.bits_));
+        }
+        constexpr flag_set_bits bitwise_xor(const flag_set_bits& other) const noexcept
+        {
+            return flag_set_bits(int_type(bits_ ^ other.bits_));
+        }
+        constexpr flag_set_bits bitwise_and(const flag_set_bits& other) const noexcept
+        {
+            return flag_set_bits(int_type(bits_ & other.bits_));
+        }
+
+        constexpr bool any() const noexcept
+        {
+            return bits_ != int_type(0u);
+        }
+        constexpr bool all() const noexcept
+        {
+            return bits_ == all_set().bits_;
+        }
+        constexpr bool equal(const flag_set_bits& other) const noexcept
+        {
+            return bits_ == other.bits_;
+        }
+
+        constexpr int_type to_int() const noexcept
+        {
+            return bits_;
+        }
+
+        std::size_t count() const noexcept
+        {
+            return popcount(bits_);
+        }
+
+        // index of the first set bit, Size if there is none
+        std::size_t find_first() const noexcept
+        {
+            return bits_ == int_type(0u) ? Size : count_trailing_zeros(bits_);
+        }
+
+        // index of the first set bit after i, Size if there is none
+        std::size_t find_next(std::size_t i) const noexcept
+        {
+            // two shifts, as i + 1 can be the number of bits
+            auto rest = std::uint_least64_t(bits_) >> i >> 1u;
+            return rest == 0u ? Size : i + 1u + count_trailing_zeros(rest);
+        }
+
+        // invokes f with the index of every set bit
+        template <typename Func>
+        void for_each(Func& f) const
+        {
+            for (std::uint_least64_t rest = bits_; rest != 0u; rest &= rest - 1u)
+                f(count_trailing_zeros(rest));
+        }
+
+    private:
+        explicit constexpr flag_set_bits(int_type bits) noexcept : bits_(bits) {}
+
+        int_type bits_;
+    };
+
+    // bits of a flag set that need multiple words,
+    // all operations are simple loops over a fixed number of words,
+    // so the optimizer can unroll and vectorize them
+    template <std::size_t Size>
+    class flag_set_bits<Size, false>
+    {
+        using word = bit_word;
+
+        static constexpr std::size_t word_bits  = bit_word_bits;
+        static constexpr std::size_t word_count = bit_word_count(Size);
+
+        static constexpr word last_word_mask() noexcept
+        {
+            return last_bit_word_mask(Size);
+        }
+
+        static constexpr word mask(std::size_t i) noexcept
+        {
+            return word(word(1u) << (i % word_bits));
+        }
+
+    public:
+        static TYPE_SAFE_CONSTEXPR14 flag_set_bits all_set() noexcept
+        {
+            flag_set_bits result;
+            for (std::size_t i = 0u; i != word_count - 1u; ++i)
+                result.words_[i] = word(~word(0u));
+            result.words_[word_count - 1u] = last_word_mask();
+            return result;
+        }
+        static constexpr flag_set_bits none_set() noexcept
+        {
+            return flag_set_bits();
+        }
+        static TYPE_SAFE_CONSTEXPR14 flag_set_bits single(std::size_t i) noexcept
+        {
+            return none_set().set(i);
+        }
+
+        static TYPE_SAFE_CONSTEXPR14 flag_set_bits filled(bool value) noexcept
+        {
+            auto result = all_set();
+            for (std::size_t i = 0u; i != word_count; ++i)
+                result.words_[i] &= word(word(0u) - value);
+            return result;
+        }
+
+        TYPE_SAFE_CONSTEXPR14 flag_set_bits set(std::size_t i) const noexcept
+        {
+            auto result = *this;
+            result.words_[i / word_bits] |= mask(i);
+            return result;
+        }
+        TYPE_SAFE_CONSTEXPR14 flag_set_bits set(std::size_t i, bool value) const noexcept
+        {
+            auto  result   = *this;
+            auto& cur_word = result.words_[i / word_bits];
+            cur_word       = word((cur_word & ~mask(i)) | (word(value) << (i % word_bits)));
+            return result;
+        }
+        TYPE_SAFE_CONSTEXPR14 flag_set_bits reset(std::size_t i) const noexcept
+        {
+            auto result = *this;
+            result.words_[i / word_bits] &= word(~mask(i));
+            return result;
+        }
+        TYPE_SAFE_CONSTEXPR14 flag_set_bits toggle(std::size_t i) const noexcept
+        {
+            auto result = *this;
+            result.words_[i / word_bits] ^= mask(i);
+            return result;
+        }
+        constexpr bool is_set(std::size_t i) const noexcept
+        {
+            return (words_[i / word_bits] & mask(i)) != word(0u);
+        }
+
+        TYPE_SAFE_CONSTEXPR14 flag_set_bits toggle_all() const noexcept
+        {
+            return bitwise_xor(all_set());
+        }
+
+        TYPE_SAFE_CONSTEXPR14 flag_set_bits bitwise_or(const flag_set_bits& other) const noexcept
+        {
+            flag_set_bits result;
+            for (std::size_t i = 0u; i != word_count; ++i)
+                result.words_[i] = words_[i] | other.words_[i];
+            return result;
+        }
+        TYPE_SAFE_CONSTEXPR14 flag_set_bits bitwise_xor(const flag_set_bits& other) const noexcept
+        {
+            flag_set_bits result;
+            for (std::size_t i = 0u; i != word_count; ++i)
+                result.words_[i] = words_[i] ^ other.words_[i];
+            return result;
+        }
+        TYPE_SAFE_CONSTEXPR14 flag_set_bits bitwise_and(const flag_set_bits& other) const noexcept
+        {
+            flag_set_bits result;
+            for (std::size_t i = 0u; i != word_count; ++i)
+                result.words_[i] = words_[i] & other.words_[i];
+            return result;
+        }
+
+        // reductions don't exit early to keep the loops branch free
+        TYPE_SAFE_CONSTEXPR14 bool any() const noexcept
+        {
+            word result(0u);
+            for (std::size_t i = 0u; i != word_count; ++i)
+                result |= words_[i];
+            return result != word(0u);
+        }
+        TYPE_SAFE_CONSTEXPR14 bool all() const noexcept
+        {
+            return equal(all_set());
+        }
+        TYPE_SAFE_CONSTEXPR14 bool equal(const flag_set_bits& other) const noexcept
+        {
+            word result(0u);
+            for (std::size_t i = 0u; i != word_count; ++i)
+                result |= words_[i] ^ other.words_[i];
+            return result == word(0u);
+        }
+
+        std::size_t count() const noexcept
+        {
+            return count_set_bits(words_, word_count);
+        }
+
+        std::size_t find_first() const noexcept
+        {
+            return find_set_bit(words_, Size, 0u);
+        }
+
+        std::size_t find_next(std::size_t i) const noexcept
+        {
+            return find_set_bit(words_, Size, i + 1u);
+        }
+
+        template <typename Func>
+        void for_each(Func& f) const
+        {
+            for_each_set_bit(words_, word_count, f);
+        }
+
+    private:
+        constexpr flag_set_bits() noexcept : words_{} {}
+
+        word words_[word_count];
+    };
+
     template <typename Enum, typename Tag = void>
     class flag_set_impl
     {
     public:
-        using traits   = flag_set_traits<Enum>;
-        using int_type = typename select_flag_set_int<traits::size()>::type;
+        using traits    = flag_set_traits<Enum>;
+        using bits_type = flag_set_bits<traits::size()>;
 
         static constexpr flag_set_impl all_set()
         {
-            return flag_set_impl(int_type((int_type(1) << traits::size()) - int_type(1)));
+            return flag_set_impl(bits_type::all_set());
         }
         static constexpr flag_set_impl none_set()
         {
-            return flag_set_impl(int_type(0));
+            return flag_set_impl(bits_type::none_set());
+        }
+        static constexpr flag_set_impl filled(bool value)
+        {
+            return flag_set_impl(bits_type::filled(value));
+        }
+
+        // only available if the flags fit into a single integer
+        template <typename Bits = bits_type>
+        static constexpr flag_set_impl from_int(typename Bits::int_type bits)
+        {
+            return flag_set_impl(Bits::from_int(bits));
         }
 
-        explicit constexpr flag_set_impl(const Enum& e) : bits_(mask(e)) {}
+        explicit constexpr flag_set_impl(const Enum& e) : bits_(bits_type::single(index(e))) {}
         template <typename Tag2>
         explicit constexpr flag_set_impl(const flag_set_impl<Enum, Tag2>& other)
         : bits_(other.bits_)
@@ -119,59 +435,95 @@ namespace detail
 
         constexpr flag_set_impl set(const Enum& e) const
         {
-            return flag_set_impl(bits_ | mask(e));
+            return flag_set_impl(bits_.set(index(e)));
+        }
+        constexpr flag_set_impl set(const Enum& e, bool value) const
+        {
+            return flag_set_impl(bits_.set(index(e), value));
         }
         constexpr flag_set_impl reset(const Enum& e) const
         {
-            return flag_set_impl(bits_ & ~mask(e));
+            return flag_set_impl(bits_.reset(index(e)));
         }
         constexpr flag_set_impl toggle(const Enum& e) const
         {
-            return flag_set_impl(bits_ ^ mask(e));
+            return flag_set_impl(bits_.toggle(index(e)));
         }
 
         constexpr flag_set_impl toggle_all() const
         {
-            return flag_set_impl(bits_ ^ all_set().to_int());
+            return flag_set_impl(bits_.toggle_all());
         }
 
-        constexpr int_type to_int() const
+        // only available if the flags fit into a single integer
+        template <typename Bits = bits_type>
+        constexpr typename Bits::int_type to_int() const
         {
-            return bits_;
+            return bits_.to_int();
         }
 
         constexpr bool is_set(const Enum& e) const
         {
-            return (bits_ & mask(e)) != int_type(0u);
+            return bits_.is_set(index(e));
+        }
+
+        constexpr bool any() const
+        {
+            return bits_.any();
+        }
+
+        constexpr bool all() const
+        {
+            return bits_.all();
+        }
+
+        template <typename Tag2>
+        constexpr bool equal(const flag_set_impl<Enum, Tag2>& other) const
+        {
+            return bits_.equal(other.bits_);
         }
 
         constexpr flag_set_impl bitwise_or(const flag_set_impl& other) const
         {
-            return flag_set_impl(bits_ | other.bits_);
+            return flag_set_impl(bits_.bitwise_or(other.bits_));
         }
 
         constexpr flag_set_impl bitwise_xor(const flag_set_impl& other) const
         {
-            return flag_set_impl(bits_ ^ other.bits_);
+            return flag_set_impl(bits_.bitwise_xor(other.bits_));
         }
 
         constexpr flag_set_impl bitwise_and(const flag_set_impl& other) const
         {
-            return flag_set_impl(bits_ & other.bits_);
+            return flag_set_impl(bits_.bitwise_and(other.bits_));
+        }
+
+        std::size_t count() const noexcept
+        {
+            return bits_.count();
+        }
+
+        const bits_type& bits() const noexcept
+        {
+            return bits_;
+        }
+
+        template <typename Func>
+        void for_each(Func& f) const
+        {
+            auto invoke = [&](std::size_t i) { f(static_cast<Enum>(i)); };
+            bits_.for_each(invoke);
         }
 
     private:
-        static constexpr int_type mask(const Enum& e)
+        static constexpr std::size_t index(const Enum& e)
         {
-            return int_type(int_type(1u) << static_cast<std::size_t>(e));
+            return static_cast<std::size_t>(e);
         }
 
-        template <typename T, typename = typename std::enable_if<std::is_integral<T>::value
-                                                                 && std::is_unsigned<T>::value>>
-        explicit constexpr flag_set_impl(T bits) : bits_(int_type(bits))
-        {}
+        explicit constexpr flag_set_impl(const bits_type& bits) : bits_(bits) {}
 
-        int_type bits_;
+        bits_type bits_;
 
         template <typename Enum2, typename Tag2>
         friend class flag_set_impl;
@@ -196,7 +548,7 @@ namespace detail
     template <typename Enum>
     constexpr bool operator==(const flag_combo<Enum>& a, const flag_combo<Enum>& b)
     {
-        return a.to_int() == b.to_int();
+        return a.equal(b);
     }
     template <typename Enum>
     constexpr bool operator==(const flag_combo<Enum>& a, const Enum& b)
@@ -254,7 +606,7 @@ namespace detail
     template <typename Enum>
     constexpr bool operator==(const flag_mask<Enum>& a, const flag_mask<Enum>& b)
     {
-        return a.to_int() == b.to_int();
+        return a.equal(b);
     }
     template <typename Enum>
     constexpr bool operator==(const flag_mask<Enum>& a, noflag_t)
@@ -444,6 +796,7 @@ public:
     //=== flag operation ===//
     /// \effects Sets the specified flag to `1` (1)/`value` (2/3).
     /// \notes (2) does not participate in overload resolution unless `T` is a boolean-like type.
+    /// \notes (2/3) are implemented without a conditional jump on the value.
     /// \group set
     void set(const Enum& flag) noexcept
     {
@@ -456,10 +809,7 @@ public:
     template <typename T, typename = detail::enable_boolean<T>>
     void set(const Enum& flag, T value) noexcept
     {
-        if (value)
-            set(flag);
-        else
-            reset(flag);
+        flags_ = flags_.set(flag, static_cast<bool>(value));
     }
 
     /// \group set
@@ -493,10 +843,7 @@ public:
     template <typename T, typename = detail::enable_boolean<T>>
     void set_all(T value) noexcept
     {
-        if (value)
-            set_all();
-        else
-            reset_all();
+        flags_ = flags_.filled(static_cast<bool>(value));
     }
 
     /// \group all
@@ -533,13 +880,13 @@ public:
     /// \returns Whether any flag is set.
     constexpr bool any() const noexcept
     {
-        return flags_.to_int() != flags_.none_set().to_int();
+        return flags_.any();
     }
 
     /// \returns Whether all flags are set.
     constexpr bool all() const noexcept
     {
-        return flags_.to_int() == flags_.all_set().to_int();
+        return flags_.all();
     }
 
     /// \returns Whether no flag is set.
@@ -548,8 +895,97 @@ public:
         return !any();
     }
 
+    /// \returns The number of flags that are set.
+    /// \notes This is a population count of the underlying integer(s).
+    std::size_t count() const noexcept
+    {
+        return flags_.count();
+    }
+
+    //=== iteration ===//
+    /// An iterator over all flags that are set, in increasing order.
+    ///
+    /// It is an `InputIterator` whose `value_type` is `Enum`.
+    /// \notes It stores a copy of the flags,
+    /// so it stays valid when the set is modified or destroyed.
+    class iterator
+    {
+    public:
+        using value_type        = Enum;
+        using reference         = Enum;
+        using pointer           = void;
+        using difference_type   = std::ptrdiff_t;
+        using iterator_category = std::input_iterator_tag;
+
+        iterator() noexcept : iterator(flags_type::none_set()) {}
+
+        reference operator*() const noexcept
+        {
+            return static_cast<Enum>(index_);
+        }
+
+        iterator& operator++() noexcept
+        {
+            index_ = bits_.find_next(index_);
+            return *this;
+        }
+
+        iterator operator++(int) noexcept
+        {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+
+        friend bool operator==(const iterator& a, const iterator& b) noexcept
+        {
+            return a.index_ == b.index_;
+        }
+
+        friend bool operator!=(const iterator& a, const iterator& b) noexcept
+        {
+            return !(a == b);
+        }
+
+    private:
+        using flags_type = detail::flag_set_impl<Enum>;
+        using bits_type  = typename flags_type::bits_type;
+
+        explicit iterator(const flags_type& flags) noexcept
+        : bits_(flags.bits()), index_(bits_.find_first())
+        {}
+
+        bits_type   bits_;
+        std::size_t index_;
+
+        friend flag_set;
+    };
+
+    /// \returns An iterator to the first flag that is set.
+    /// \notes Iterating over the set is proportional to the number of flags that are set,
+    /// not the number of all flags.
+    iterator begin() const noexcept
+    {
+        return iterator(flags_);
+    }
+
+    /// \returns The end iterator.
+    iterator end() const noexcept
+    {
+        return iterator(flags_.none_set());
+    }
+
+    /// \effects Invokes `f` with every flag that is set, in increasing order.
+    /// \notes This is more efficient than iterating using `begin()`/`end()`.
+    template <typename Func>
+    void for_each_set(Func&& f) const
+    {
+        flags_.for_each(f);
+    }
+
     /// \returns An integer where each bit has the value of the corresponding flag.
-    /// \requires `T` must be an unsigned integer type with enough bits.
+    /// \requires `T` must be an unsigned integer type with enough bits,
+    /// so it is not available for flags with more enumerators than the biggest integer type has bits.
     template <typename T>
     constexpr T to_int() const noexcept
     {
@@ -755,7 +1191,7 @@ constexpr flag_set<Enum> operator&(const flag_mask<Enum>& a, const flag_set<Enum
 template <typename Enum, typename FlagCombo, typename = detail::enable_flag_combo<FlagCombo, Enum>>
 constexpr bool operator&(const flag_set<Enum>& a, const FlagCombo& b)
 {
-    return static_cast<bool>(combo(a).bitwise_and(flag_combo<Enum>(b)).to_int());
+    return combo(a).bitwise_and(flag_combo<Enum>(b)).any();
 }
 /// \group bitwise_and_check
 /// \param 2
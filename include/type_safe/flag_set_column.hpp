@@ -0,0 +1,114 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_FLAG_SET_COLUMN_HPP_INCLUDED
+#define TYPE_SAFE_FLAG_SET_COLUMN_HPP_INCLUDED
+
+#include <vector>
+
+#include <type_safe/boolean_vector.hpp>
+#include <type_safe/detail/assert.hpp>
+#include <type_safe/flag_set.hpp>
+#include <type_safe/reference.hpp>
+
+namespace type_safe
+{
+/// A column of [ts::flag_set]() values, one per row, stored transposed.
+///
+/// Instead of storing a [ts::flag_set]() per row,
+/// it stores a [ts::boolean_vector]() per flag, where the `i`th element is the flag of row `i`.
+/// This allows evaluating queries such as "all rows where `a` and `b` are set but `c` isn't"
+/// over the entire column one word of 64 rows at a time,
+/// instead of evaluating the [ts::flag_set]() operators row by row.
+///
+/// \requires `Enum` must be a flag,
+/// i.e. valid with the [ts::flag_set_traits]().
+template <typename Enum>
+class flag_set_column
+{
+    static_assert(std::is_enum<Enum>::value, "not an enum");
+    static_assert(flag_set_traits<Enum>::value, "invalid enum for flag_set");
+
+public:
+    //=== constructors ===//
+    /// \effects Creates a column without any rows.
+    flag_set_column() : columns_(flag_set_traits<Enum>::size()) {}
+
+    /// \effects Creates a column containing the given flag sets as rows.
+    explicit flag_set_column(array_ref<const flag_set<Enum>> rows)
+    : columns_(flag_set_traits<Enum>::size(),
+               boolean_vector(static_cast<std::size_t>(rows.size()))),
+      size_(static_cast<std::size_t>(rows.size()))
+    {
+        for (std::size_t row = 0u; row != size_; ++row)
+            rows.data()[row].for_each_set([&](const Enum& f) { columns_[index(f)][row] = true; });
+    }
+
+    //=== rows ===//
+    /// \returns The number of rows.
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    /// \effects Appends a row.
+    void push_back(const flag_set<Enum>& set)
+    {
+        for (std::size_t i = 0u; i != columns_.size(); ++i)
+            columns_[i].push_back(set.is_set(static_cast<Enum>(i)));
+        ++size_;
+    }
+
+    /// \returns The flag set of the given row.
+    /// \requires `row < size()`.
+    flag_set<Enum> operator[](std::size_t row) const noexcept
+    {
+        DEBUG_ASSERT(row < size_, detail::precondition_error_handler{}, "row out of range");
+        flag_set<Enum> result;
+        for (std::size_t i = 0u; i != columns_.size(); ++i)
+            result.set(static_cast<Enum>(i), columns_[i][row]);
+        return result;
+    }
+
+    /// \returns The bitmap of all rows where the given flag is set.
+    const boolean_vector& column(const Enum& f) const noexcept
+    {
+        return columns_[index(f)];
+    }
+
+    //=== queries ===//
+    /// \returns The bitmap of all rows where all the flags of `required` are set,
+    /// and no flag that is cleared in `allowed` is set.
+    /// \notes For example, `column.matching(a | b, ~c)` returns all rows where `a` and `b` are
+    /// set, but `c` isn't.
+    boolean_vector matching(const flag_set<Enum>&  required,
+                            const flag_mask<Enum>& allowed = flag_mask<Enum>::all_set()) const
+    {
+        boolean_vector result(size_, true);
+        required.for_each_set([&](const Enum& f) { result &= column(f); });
+        flag_set<Enum>(~allowed).for_each_set(
+            [&](const Enum& f) { result.and_not(column(f)); });
+        return result;
+    }
+
+    /// \returns The bitmap of all rows where at least one of the flags of `flags` is set.
+    boolean_vector matching_any(const flag_set<Enum>& flags) const
+    {
+        boolean_vector result(size_);
+        flags.for_each_set([&](const Enum& f) { result |= column(f); });
+        return result;
+    }
+
+private:
+    static std::size_t index(const Enum& f) noexcept
+    {
+        return static_cast<std::size_t>(f);
+    }
+
+    std::vector<boolean_vector> columns_;
+    std::size_t                 size_ = 0u;
+};
+} // namespace type_safe
+
+#endif // TYPE_SAFE_FLAG_SET_COLUMN_HPP_INCLUDED
@@ -0,0 +1,264 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_FLAG_SET_FORMAT_HPP_INCLUDED
+#define TYPE_SAFE_FLAG_SET_FORMAT_HPP_INCLUDED
+
+#include <cstdint>
+
+#include <type_safe/config.hpp>
+#include <type_safe/flag_set.hpp>
+#include <type_safe/optional.hpp>
+
+namespace type_safe
+{
+/// \exclude
+namespace detail
+{
+    // 64bit FNV-1a
+    inline TYPE_SAFE_CONSTEXPR14 std::uint_least64_t flag_name_hash(const char* str,
+                                                                    std::size_t length) noexcept
+    {
+        std::uint_least64_t hash = 14695981039346656037ull;
+        for (std::size_t i = 0u; i != length; ++i)
+        {
+            hash ^= static_cast<unsigned char>(str[i]);
+            hash = (hash * 1099511628211ull) & 0xFFFFFFFFFFFFFFFFull;
+        }
+        return hash;
+    }
+
+    inline TYPE_SAFE_CONSTEXPR14 std::size_t flag_name_length(const char* str) noexcept
+    {
+        std::size_t length = 0u;
+        while (str[length] != '\0')
+            ++length;
+        return length;
+    }
+
+    inline TYPE_SAFE_CONSTEXPR14 bool flag_name_equal(const char* name, const char* str,
+                                                      std::size_t length) noexcept
+    {
+        for (std::size_t i = 0u; i != length; ++i)
+            // str can contain a null character, so stop at the end of name explicitly
+            if (name[i] == '\0' || name[i] != str[i])
+                return false;
+        return name[length] == '\0';
+    }
+
+    // smallest power of two that is >= size
+    constexpr std::size_t flag_name_table_size(std::size_t size, std::size_t result = 1u) noexcept
+    {
+        return result >= size ? result : flag_name_table_size(size, 2u * result);
+    }
+
+    // A minimal perfect hash of the enumerator names, using hash and displace:
+    // the low bits of the hash select a bucket,
+    // the seed of the bucket then maps each name of the bucket to its own slot.
+    template <std::size_t Size>
+    struct flag_name_table
+    {
+        static constexpr std::size_t table_size = flag_name_table_size(Size);
+        // upper bound for the seed search, the table falls back to linear search if exceeded
+        static constexpr std::uint_least32_t max_seed = 1u << 16;
+
+        std::uint_least32_t seeds[table_size];
+        std::size_t         slots[table_size]; // index of the enumerator or Size if empty
+        bool                valid;
+
+        constexpr flag_name_table() noexcept : seeds{}, slots{}, valid(false) {}
+
+        static constexpr std::size_t bucket(std::uint_least64_t hash) noexcept
+        {
+            return static_cast<std::size_t>(hash & (table_size - 1u));
+        }
+
+        static constexpr std::size_t slot(std::uint_least64_t hash,
+                                          std::uint_least32_t seed) noexcept
+        {
+            return static_cast<std::size_t>(
+                (((hash * (2u * std::uint_least64_t(seed) + 1u)) & 0xFFFFFFFFFFFFFFFFull) >> 32)
+                & (table_size - 1u));
+        }
+
+        TYPE_SAFE_CONSTEXPR14 std::size_t lookup(std::uint_least64_t hash) const noexcept
+        {
+            return slots[slot(hash, seeds[bucket(hash)])];
+        }
+
+        // tries to place all names of the given bucket with the given seed
+        TYPE_SAFE_CONSTEXPR14 bool place(const std::uint_least64_t* hashes, std::size_t b,
+                                         std::uint_least32_t seed) noexcept
+        {
+            for (std::size_t i = 0u; i != Size; ++i)
+            {
+                if (bucket(hashes[i]) != b)
+                    continue;
+
+                auto& cur = slots[slot(hashes[i], seed)];
+                if (cur != Size)
+                {
+                    // undo the names placed so far
+                    for (std::size_t j = 0u; j != i; ++j)
+                        if (bucket(hashes[j]) == b)
+                            slots[slot(hashes[j], seed)] = Size;
+                    return false;
+                }
+                cur = i;
+            }
+            seeds[b] = seed;
+            return true;
+        }
+    };
+
+    template <typename Enum>
+    TYPE_SAFE_CONSTEXPR14 flag_name_table<flag_set_traits<Enum>::size()>
+        make_flag_name_table() noexcept
+    {
+        using table = flag_name_table<flag_set_traits<Enum>::size()>;
+        using names = flag_set_names<Enum>;
+
+        table               result;
+        std::uint_least64_t hashes[flag_set_traits<Enum>::size()]{};
+        std::size_t         bucket_sizes[table::table_size]{};
+        for (std::size_t i = 0u; i != flag_set_traits<Enum>::size(); ++i)
+        {
+            hashes[i] = flag_name_hash(names::name(i), flag_name_length(names::name(i)));
+            ++bucket_sizes[table::bucket(hashes[i])];
+        }
+        for (std::size_t i = 0u; i != table::table_size; ++i)
+            result.slots[i] = flag_set_traits<Enum>::size();
+
+        // place the biggest buckets first, while most slots are still free
+        for (auto size = flag_set_traits<Enum>::size(); size != 0u; --size)
+            for (std::size_t b = 0u; b != table::table_size; ++b)
+            {
+                if (bucket_sizes[b] != size)
+                    continue;
+
+                std::uint_least32_t seed = 0u;
+                while (!result.place(hashes, b, seed))
+                    if (++seed == table::max_seed)
+                        // give up, happens only if two names have the same hash
+                        return result;
+            }
+
+        result.valid = true;
+        return result;
+    }
+
+    template <typename Enum>
+    const flag_name_table<flag_set_traits<Enum>::size()>& get_flag_name_table() noexcept
+    {
+        // constant initialized if possible
+        static const auto table = make_flag_name_table<Enum>();
+        return table;
+    }
+
+    // returns the index of the enumerator with the given name or the size if there is none
+    template <typename Enum>
+    std::size_t find_flag_name(const char* str, std::size_t length) noexcept
+    {
+        static_assert(flag_set_names<Enum>::value, "flag_set_names not specialized");
+        using names = flag_set_names<Enum>;
+
+        auto& table = get_flag_name_table<Enum>();
+        if (table.valid)
+        {
+            auto index = table.lookup(flag_name_hash(str, length));
+            return index != flag_set_traits<Enum>::size()
+                           && flag_name_equal(names::name(index), str, length)
+                       ? index
+                       : flag_set_traits<Enum>::size();
+        }
+
+        for (std::size_t i = 0u; i != flag_set_traits<Enum>::size(); ++i)
+            if (flag_name_equal(names::name(i), str, length))
+                return i;
+        return flag_set_traits<Enum>::size();
+    }
+} // namespace detail
+
+/// \returns The name of the given flag.
+/// \requires `Enum` must be a flag with [ts::flag_set_names]().
+template <typename Enum>
+constexpr const char* flag_name(const Enum& f) noexcept
+{
+    static_assert(flag_set_names<Enum>::value, "flag_set_names not specialized");
+    return flag_set_names<Enum>::name(static_cast<std::size_t>(f));
+}
+
+/// \returns The flag with the given name, or [ts::nullopt]() if there is none.
+/// \notes The string does not need to be null-terminated.
+/// The flag is found using a perfect hash table of the names.
+/// \requires `Enum` must be a flag with [ts::flag_set_names]().
+template <typename Enum>
+optional<Enum> parse_flag(const char* str, std::size_t length) noexcept
+{
+    auto index = detail::find_flag_name<Enum>(str, length);
+    if (index == flag_set_traits<Enum>::size())
+        return nullopt;
+    return static_cast<Enum>(index);
+}
+
+/// \effects Writes the names of all flags that are set into the buffer,
+/// separated by `|` and in the order of the enumerators, e.g. `a|b|c`.
+/// At most `size` characters are written, no null terminator is added.
+/// \returns The number of characters of the complete output,
+/// if it is greater than `size`, the output has been truncated.
+/// \notes This function never allocates memory.
+/// \requires `Enum` must be a flag with [ts::flag_set_names]().
+template <typename Enum>
+std::size_t format_flag_set(const flag_set<Enum>& set, char* buffer, std::size_t size) noexcept
+{
+    std::size_t length = 0u;
+    auto        write  = [&](char c) {
+        if (length < size)
+            buffer[length] = c;
+        ++length;
+    };
+
+    set.for_each_set([&](const Enum& f) {
+        if (length != 0u)
+            write('|');
+        for (auto name = flag_name(f); *name != '\0'; ++name)
+            write(*name);
+    });
+    return length;
+}
+
+/// \returns The flag set where exactly the flags named in the string are set,
+/// or [ts::nullopt]() if the string contains an unknown or empty name.
+/// The names must be separated by `|`, the empty string results in [ts::noflag]().
+/// \notes The string does not need to be null-terminated.
+/// Every name is found using a perfect hash table of the names.
+/// \requires `Enum` must be a flag with [ts::flag_set_names]().
+template <typename Enum>
+optional<flag_set<Enum>> parse_flag_set(const char* str, std::size_t length) noexcept
+{
+    flag_set<Enum> result;
+    if (length == 0u)
+        return result;
+
+    auto end = str + length;
+    for (auto begin = str;; ++begin)
+    {
+        auto cur = begin;
+        while (cur != end && *cur != '|')
+            ++cur;
+
+        auto flag = parse_flag<Enum>(begin, static_cast<std::size_t>(cur - begin));
+        if (!flag)
+            return nullopt;
+        result.set(flag.value());
+
+        if (cur == end)
+            break;
+        begin = cur;
+    }
+    return result;
+}
+} // namespace type_safe
+
+#endif // TYPE_SAFE_FLAG_SET_FORMAT_HPP_INCLUDED
@@ -9,6 +9,7 @@
 #include <iosfwd>
 #include <type_traits>
 
+#include <type_safe/boolean.hpp>
 #include <type_safe/detail/force_inline.hpp>
 
 namespace type_safe
@@ -407,6 +408,18 @@ TYPE_SAFE_DETAIL_MAKE_OP(/)
 
 #undef TYPE_SAFE_DETAIL_MAKE_OP
 
+/// Branch-free selection of a [ts::floating_point]().
+/// \returns `a` if `cond` is `true`, `b` otherwise.
+/// \notes It is implemented without a conditional jump.
+/// \module types
+template <typename FloatT>
+TYPE_SAFE_FORCE_INLINE TYPE_SAFE_CONSTEXPR14 floating_point<FloatT> select(
+    boolean cond, const floating_point<FloatT>& a, const floating_point<FloatT>& b) noexcept
+{
+    return floating_point<FloatT>(detail::select(std::false_type{}, static_cast<bool>(cond),
+                                                 static_cast<FloatT>(a), static_cast<FloatT>(b)));
+}
+
 //=== input/output ===/
 /// \effects Reads a float from the [std::istream]() and assigns it to the given
 /// [ts::floating_point](). \module types \output_section Input/output
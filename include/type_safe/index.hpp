@@ -6,38 +6,107 @@
 #define TYPE_SAFE_INDEX_HPP_INCLUDED
 
 #include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
 
 #include <type_safe/config.hpp>
+#include <type_safe/narrow_cast.hpp>
 #include <type_safe/strong_typedef.hpp>
 #include <type_safe/types.hpp>
 
 namespace type_safe
 {
-/// A type modelling the difference between two [ts::index_t]() objects.
+/// \exclude
+namespace detail
+{
+#if TYPE_SAFE_ENABLE_WRAPPER
+    template <typename T>
+    using index_integer = integer<T>;
+#else
+    template <typename T>
+    using index_integer = T;
+#endif
+
+    // the index arithmetic is done modulo 2^N in the unsigned type,
+    // it is valid if the result didn't wrap around
+    template <typename Unsigned, typename Signed>
+    constexpr bool index_add_valid(Unsigned index, Signed dist, Unsigned result) noexcept
+    {
+        return (dist < 0) == (result < index);
+    }
+
+    template <typename Unsigned, typename Signed>
+    constexpr Unsigned index_add(Unsigned index, Signed dist) noexcept
+    {
+        return index_add_valid(index, dist,
+                               static_cast<Unsigned>(index + static_cast<Unsigned>(dist)))
+                   ? static_cast<Unsigned>(index + static_cast<Unsigned>(dist))
+                   : DEBUG_UNREACHABLE(detail::precondition_error_handler{},
+                                       "index arithmetic out of range");
+    }
+
+    template <typename Unsigned, typename Signed>
+    constexpr bool index_sub_valid(Unsigned index, Signed dist, Unsigned result) noexcept
+    {
+        return (dist < 0) == (result > index);
+    }
+
+    template <typename Unsigned, typename Signed>
+    constexpr Unsigned index_sub(Unsigned index, Signed dist) noexcept
+    {
+        return index_sub_valid(index, dist,
+                               static_cast<Unsigned>(index - static_cast<Unsigned>(dist)))
+                   ? static_cast<Unsigned>(index - static_cast<Unsigned>(dist))
+                   : DEBUG_UNREACHABLE(detail::precondition_error_handler{},
+                                       "index arithmetic out of range");
+    }
+
+    // distance of a and b = a - b, if a < b it is -(b - a - 1) - 1 to allow the minimum value
+    template <typename Signed, typename Unsigned>
+    constexpr Signed index_distance(Unsigned a, Unsigned b) noexcept
+    {
+        return (a >= b ? static_cast<Unsigned>(a - b) : static_cast<Unsigned>(b - a - 1u))
+                       > static_cast<Unsigned>(std::numeric_limits<Signed>::max())
+                   ? DEBUG_UNREACHABLE(detail::precondition_error_handler{},
+                                       "index distance out of range")
+                   : a >= b ? static_cast<Signed>(a - b)
+                            : static_cast<Signed>(-static_cast<Signed>(b - a - 1u) - 1);
+    }
+} // namespace detail
+
+/// The common base class of [ts::difference_t]() and [ts::difference32_t]().
 ///
-/// It is a [ts::strong_typedef]() for [ts::ptrdiff_t]().
+/// It is a [ts::strong_typedef]() for the [ts::integer]() of `SignedInteger`,
+/// `Difference` is the derived class.
 /// It is comparable and you can add and subtract two differences.
+/// Differences of different types convert implicitly if no narrowing is possible,
+/// otherwise the conversion is explicit and checks for narrowing.
 /// \module types
-struct difference_t : strong_typedef<difference_t, ptrdiff_t>,
-                      strong_typedef_op::equality_comparison<difference_t>,
-                      strong_typedef_op::relational_comparison<difference_t>,
-                      strong_typedef_op::unary_plus<difference_t>,
-                      strong_typedef_op::unary_minus<difference_t>,
-                      strong_typedef_op::addition<difference_t>,
-                      strong_typedef_op::subtraction<difference_t>
+template <class Difference, typename SignedInteger>
+struct basic_difference : strong_typedef<Difference, detail::index_integer<SignedInteger>>,
+                          strong_typedef_op::equality_comparison<Difference>,
+                          strong_typedef_op::relational_comparison<Difference>,
+                          strong_typedef_op::unary_plus<Difference>,
+                          strong_typedef_op::unary_minus<Difference>,
+                          strong_typedef_op::addition<Difference>,
+                          strong_typedef_op::subtraction<Difference>
 {
+    static_assert(std::is_signed<SignedInteger>::value, "difference must be signed");
+
     /// \effects Initializes it to `0`.
-    constexpr difference_t() noexcept : strong_typedef(0) {}
+    constexpr basic_difference() noexcept : basic_difference::strong_typedef(0) {}
 
     /// \effects Initializes it from a valid `signed` integer type.
     /// \notes This constructor does not participate in overload resolution,
-    /// if `T` is not safely convertible to [ts::ptrdiff_t]().
+    /// if `T` is not safely convertible to `SignedInteger`.
     /// \group int_ctor
     /// \param 1
     /// \exclude
     template <typename T, typename = typename std::enable_if<
-                              detail::is_safe_integer_conversion<T, std::ptrdiff_t>::value>::type>
-    constexpr difference_t(T i) noexcept : strong_typedef(i)
+                              detail::is_safe_integer_conversion<T, SignedInteger>::value>::type>
+    constexpr basic_difference(T i) noexcept : basic_difference::strong_typedef(i)
     {}
 
     /// \group int_ctor
@@ -45,38 +114,74 @@ struct difference_t : strong_typedef<difference_t, ptrdiff_t>,
     /// \exclude
     template <typename T, class Policy,
               typename = typename std::enable_if<
-                  detail::is_safe_integer_conversion<T, std::ptrdiff_t>::value>::type>
-    constexpr difference_t(integer<T, Policy> i) noexcept : strong_typedef(static_cast<T>(i))
+                  detail::is_safe_integer_conversion<T, SignedInteger>::value>::type>
+    constexpr basic_difference(integer<T, Policy> i) noexcept
+    : basic_difference::strong_typedef(static_cast<T>(i))
+    {}
+
+    /// \effects Initializes it from a difference of a smaller or equal type.
+    /// \group difference_ctor
+    /// \param 2
+    /// \exclude
+    template <class OtherDifference, typename T,
+              typename = typename std::enable_if<
+                  detail::is_safe_integer_conversion<T, SignedInteger>::value>::type>
+    constexpr basic_difference(const basic_difference<OtherDifference, T>& d) noexcept
+    : basic_difference::strong_typedef(static_cast<T>(get(d)))
+    {}
+
+    /// \effects Initializes it from a difference of a bigger type.
+    /// \requires The value must be representable in `SignedInteger`.
+    /// \group difference_ctor
+    /// \param 2
+    /// \exclude
+    /// \param 3
+    /// \exclude
+    template <class OtherDifference, typename T,
+              typename = typename std::enable_if<
+                  !detail::is_safe_integer_conversion<T, SignedInteger>::value>::type,
+              typename = void>
+    explicit constexpr basic_difference(const basic_difference<OtherDifference, T>& d) noexcept
+    : basic_difference::strong_typedef(narrow_cast<SignedInteger>(static_cast<T>(get(d))))
     {}
 };
 
-/// A type modelling an index into an array.
+/// The common base class of [ts::index_t]() and [ts::index32_t]().
 ///
-/// It is a [ts::strong_typedef]() for [ts::size_t]().
+/// It is a [ts::strong_typedef]() for the [ts::integer]() of `UnsignedInteger`,
+/// `Index` is the derived class and `Difference` the corresponding [ts::basic_difference]().
 /// It is comparable and you can increment and decrement it,
-/// as well as adding/subtracting a [ts::distance_t]().
+/// as well as adding/subtracting a `Difference`.
+/// Indices of different types convert implicitly if no narrowing is possible,
+/// otherwise the conversion is explicit and checks for narrowing.
 /// \notes It has a similar interface to a `RandomAccessIterator`,
 /// but without the dereference functions.
 /// \module types
-struct index_t : strong_typedef<index_t, size_t>,
-                 strong_typedef_op::equality_comparison<index_t>,
-                 strong_typedef_op::relational_comparison<index_t>,
-                 strong_typedef_op::increment<index_t>,
-                 strong_typedef_op::decrement<index_t>,
-                 strong_typedef_op::unary_plus<index_t>
+template <class Index, typename UnsignedInteger, class Difference>
+struct basic_index : strong_typedef<Index, detail::index_integer<UnsignedInteger>>,
+                     strong_typedef_op::equality_comparison<Index>,
+                     strong_typedef_op::relational_comparison<Index>,
+                     strong_typedef_op::increment<Index>,
+                     strong_typedef_op::decrement<Index>,
+                     strong_typedef_op::unary_plus<Index>
 {
+    static_assert(std::is_unsigned<UnsignedInteger>::value, "index must be unsigned");
+
+    /// The corresponding [ts::basic_difference]().
+    using difference_type = Difference;
+
     /// \effects Initializes it to `0`.
-    constexpr index_t() noexcept : strong_typedef(0u) {}
+    constexpr basic_index() noexcept : basic_index::strong_typedef(0u) {}
 
     /// \effects Initializes it from a valid `unsigned` integer type.
     /// \notes This constructor does not participate in overload resolution,
-    /// if `T` is not safely convertible to [ts::size_t]().
+    /// if `T` is not safely convertible to `UnsignedInteger`.
     /// \group int_ctor
     /// \param 1
     /// \exclude
     template <typename T, typename = typename std::enable_if<
-                              detail::is_safe_integer_conversion<T, std::size_t>::value>::type>
-    constexpr index_t(T i) noexcept : strong_typedef(i)
+                              detail::is_safe_integer_conversion<T, UnsignedInteger>::value>::type>
+    constexpr basic_index(T i) noexcept : basic_index::strong_typedef(i)
     {}
 
     /// \group int_ctor
@@ -84,35 +189,138 @@ struct index_t : strong_typedef<index_t, size_t>,
     /// \exclude
     template <typename T, class Policy,
               typename = typename std::enable_if<
-                  detail::is_safe_integer_conversion<T, std::size_t>::value>::type>
-    constexpr index_t(integer<T, Policy> i) noexcept : strong_typedef(static_cast<T>(i))
+                  detail::is_safe_integer_conversion<T, UnsignedInteger>::value>::type>
+    constexpr basic_index(integer<T, Policy> i) noexcept
+    : basic_index::strong_typedef(static_cast<T>(i))
+    {}
+
+    /// \effects Initializes it from an index of a smaller or equal type.
+    /// \group index_ctor
+    /// \param 3
+    /// \exclude
+    template <class OtherIndex, typename T, class OtherDifference,
+              typename = typename std::enable_if<
+                  detail::is_safe_integer_conversion<T, UnsignedInteger>::value>::type>
+    constexpr basic_index(const basic_index<OtherIndex, T, OtherDifference>& i) noexcept
+    : basic_index::strong_typedef(static_cast<T>(get(i)))
+    {}
+
+    /// \effects Initializes it from an index of a bigger type.
+    /// \requires The value must be representable in `UnsignedInteger`.
+    /// \group index_ctor
+    /// \param 3
+    /// \exclude
+    /// \param 4
+    /// \exclude
+    template <class OtherIndex, typename T, class OtherDifference,
+              typename = typename std::enable_if<
+                  !detail::is_safe_integer_conversion<T, UnsignedInteger>::value>::type,
+              typename = void>
+    explicit constexpr basic_index(const basic_index<OtherIndex, T, OtherDifference>& i) noexcept
+    : basic_index::strong_typedef(narrow_cast<UnsignedInteger>(static_cast<T>(get(i))))
     {}
 
     /// \effects Advances the index by the distance specified in `rhs`.
     /// If `rhs` is a negative distance, it advances backwards.
-    /// \requires The new index must be greater or equal to `0`.
-    index_t& operator+=(const difference_t& rhs) noexcept
+    /// \requires The new index must be greater or equal to `0`
+    /// and representable in `UnsignedInteger`.
+    Index& operator+=(const Difference& rhs) noexcept
     {
-        get(*this) = make_unsigned(make_signed(get(*this)) + get(rhs));
-        return *this;
+        get(*this) = detail::index_add(static_cast<UnsignedInteger>(get(*this)), raw(rhs));
+        return static_cast<Index&>(*this);
     }
 
     /// \effects Advances the index backwards by the distance specified in `rhs`.
     /// If `rhs` is a negative distance, it advances forwards.
-    /// \requires The new index must be greater or equal to `0`.
-    index_t& operator-=(const difference_t& rhs) noexcept
+    /// \requires The new index must be greater or equal to `0`
+    /// and representable in `UnsignedInteger`.
+    Index& operator-=(const Difference& rhs) noexcept
+    {
+        get(*this) = detail::index_sub(static_cast<UnsignedInteger>(get(*this)), raw(rhs));
+        return static_cast<Index&>(*this);
+    }
+
+private:
+    static constexpr typename std::make_signed<UnsignedInteger>::type raw(
+        const Difference& d) noexcept
     {
-        get(*this) = make_unsigned(make_signed(get(*this)) - get(rhs));
-        return *this;
+        return static_cast<typename std::make_signed<UnsignedInteger>::type>(get(d));
     }
 };
 
-/// \returns The given [ts::index_t]() advanced by the given [ts::distance_t]().
+/// A type modelling the difference between two [ts::index_t]() objects.
+///
+/// It is the [ts::basic_difference]() for [ts::ptrdiff_t]().
+/// \module types
+struct difference_t : basic_difference<difference_t, std::make_signed<std::size_t>::type>
+{
+    using basic_difference::basic_difference;
+};
+
+/// A type modelling an index into an array.
+///
+/// It is the [ts::basic_index]() for [ts::size_t]().
+/// \module types
+struct index_t : basic_index<index_t, std::size_t, difference_t>
+{
+    using basic_index::basic_index;
+};
+
+/// A type modelling the difference between two [ts::index32_t]() objects.
+///
+/// It is the [ts::basic_difference]() for [ts::int32_t](),
+/// only half the size of [ts::difference_t]() on 64bit platforms.
+/// It converts implicitly to [ts::difference_t](),
+/// the other direction is explicit and checks for narrowing.
+/// \module types
+struct difference32_t : basic_difference<difference32_t, std::int32_t>
+{
+    using basic_difference::basic_difference;
+};
+
+/// A type modelling an index into an array with at most `2^32` elements.
+///
+/// It is the [ts::basic_index]() for [ts::uint32_t](),
+/// only half the size of [ts::index_t]() on 64bit platforms,
+/// which matters for data structures storing a lot of indices,
+/// like the adjacency lists of a graph.
+/// It converts implicitly to [ts::index_t](), so it can be used with [ts::at](),
+/// the other direction is explicit and checks for narrowing.
+/// \module types
+struct index32_t : basic_index<index32_t, std::uint32_t, difference32_t>
+{
+    using basic_index::basic_index;
+};
+
+/// \returns The given index advanced by the given difference.
+/// \requires The new index must be greater or equal to `0`
+/// and representable in `UnsignedInteger`.
+/// \notes The overloads for [ts::index_t]() also accept types that convert to it implicitly,
+/// like a [ts::valid_index]().
 /// \module types
+/// \group index_distance_plus
+template <class Index, typename UnsignedInteger, class Difference>
+constexpr Index operator+(const basic_index<Index, UnsignedInteger, Difference>& lhs,
+                          const Difference&                                      rhs) noexcept
+{
+    return Index(
+        detail::index_add(static_cast<UnsignedInteger>(get(lhs)),
+                          static_cast<typename std::make_signed<UnsignedInteger>::type>(get(rhs))));
+}
+
+/// \group index_distance_plus
+template <class Index, typename UnsignedInteger, class Difference>
+constexpr Index operator+(const Difference&                                      lhs,
+                          const basic_index<Index, UnsignedInteger, Difference>& rhs) noexcept
+{
+    return rhs + lhs;
+}
+
 /// \group index_distance_plus
 constexpr index_t operator+(const index_t& lhs, const difference_t& rhs) noexcept
 {
-    return index_t(make_unsigned(make_signed(get(lhs)) + get(rhs)));
+    return index_t(detail::index_add(static_cast<std::size_t>(get(lhs)),
+                                     static_cast<std::make_signed<std::size_t>::type>(get(rhs))));
 }
 
 /// \group index_distance_plus
@@ -121,20 +329,46 @@ constexpr index_t operator+(const difference_t& lhs, const index_t& rhs) noexcep
     return rhs + lhs;
 }
 
-/// \returns The given [ts::index_t]() advanced backwards by the given [ts::distance_t]().
+/// \returns The given index advanced backwards by the given difference.
+/// \requires The new index must be greater or equal to `0`
+/// and representable in `UnsignedInteger`.
 /// \module types
+/// \group index_distance_minus
+template <class Index, typename UnsignedInteger, class Difference>
+constexpr Index operator-(const basic_index<Index, UnsignedInteger, Difference>& lhs,
+                          const Difference&                                      rhs) noexcept
+{
+    return Index(
+        detail::index_sub(static_cast<UnsignedInteger>(get(lhs)),
+                          static_cast<typename std::make_signed<UnsignedInteger>::type>(get(rhs))));
+}
+
+/// \group index_distance_minus
 constexpr index_t operator-(const index_t& lhs, const difference_t& rhs) noexcept
 {
-    return index_t(make_unsigned(make_signed(get(lhs)) - get(rhs)));
+    return index_t(detail::index_sub(static_cast<std::size_t>(get(lhs)),
+                                     static_cast<std::make_signed<std::size_t>::type>(get(rhs))));
 }
 
 /// \returns Returns the distance between two indices.
 /// This is the number of steps you need to increment `lhs` to reach `rhs`,
 /// it is negative if `lhs > rhs`.
+/// \requires The distance must be representable in the signed type.
 /// \module types
+/// \group index_index_minus
+template <class Index, typename UnsignedInteger, class Difference>
+constexpr Difference operator-(const basic_index<Index, UnsignedInteger, Difference>& lhs,
+                               const basic_index<Index, UnsignedInteger, Difference>& rhs) noexcept
+{
+    return Difference(detail::index_distance<typename std::make_signed<UnsignedInteger>::type>(
+        static_cast<UnsignedInteger>(get(lhs)), static_cast<UnsignedInteger>(get(rhs))));
+}
+
+/// \group index_index_minus
 constexpr difference_t operator-(const index_t& lhs, const index_t& rhs) noexcept
 {
-    return difference_t(make_signed(get(lhs)) - make_signed(get(rhs)));
+    return difference_t(detail::index_distance<std::make_signed<std::size_t>::type>(
+        static_cast<std::size_t>(get(lhs)), static_cast<std::size_t>(get(rhs))));
 }
 
 /// \exclude
@@ -174,8 +408,213 @@ namespace detail
     {
         return index < Size;
     }
+
+    template <typename Indexable>
+    auto index_size(non_member_size, const Indexable& obj)
+        -> decltype(static_cast<std::size_t>(size(obj)))
+    {
+        return static_cast<std::size_t>(size(obj));
+    }
+
+    template <typename Indexable>
+    auto index_size(member_size, const Indexable& obj)
+        -> decltype(static_cast<std::size_t>(obj.size()))
+    {
+        return static_cast<std::size_t>(obj.size());
+    }
+
+    template <typename T, std::size_t Size>
+    constexpr std::size_t index_size(member_size, const T (&)[Size]) noexcept
+    {
+        return Size;
+    }
+
+    template <typename Indexable>
+    using index_container =
+        typename std::remove_cv<typename std::remove_reference<Indexable>::type>::type;
+
+    // the object a valid_index has been created for,
+    // only stored if it is needed to check the precondition of at()
+#if TYPE_SAFE_ENABLE_PRECONDITION_CHECKS
+    class index_owner
+    {
+    public:
+        explicit constexpr index_owner(const void* obj) noexcept : obj_(obj) {}
+
+        constexpr bool is_owner(const void* obj) const noexcept
+        {
+            return obj_ == obj;
+        }
+
+    private:
+        const void* obj_;
+    };
+#else
+    class index_owner
+    {
+    public:
+        explicit constexpr index_owner(const void*) noexcept {}
+
+        constexpr bool is_owner(const void*) const noexcept
+        {
+            return true;
+        }
+    };
+#endif
+
+    template <typename Indexable>
+    class index_iterator;
+} // namespace detail
+
+/// An [ts::index_t]() that is known to be valid for an object of type `Indexable`.
+///
+/// It is created by iterating over [ts::indices](),
+/// which checks the size of the object only once.
+/// Then [ts::at]() does not need to check it on every access.
+/// \notes If [TYPE_SAFE_ENABLE_PRECONDITION_CHECKS]() is `true`,
+/// it also stores the address of the object,
+/// so [ts::at]() can check that it is used with the same object in constant time.
+/// \module types
+template <typename Indexable>
+class valid_index : detail::index_owner
+{
+public:
+    /// \returns The index.
+    constexpr const index_t& get_index() const noexcept
+    {
+        return index_;
+    }
+
+    /// \returns The index.
+    constexpr operator const index_t&() const noexcept
+    {
+        return index_;
+    }
+
+private:
+    explicit constexpr valid_index(const index_t& index, const detail::index_owner& owner) noexcept
+    : detail::index_owner(owner), index_(index)
+    {}
+
+    index_t index_;
+
+    friend detail::index_iterator<Indexable>;
+};
+
+/// \exclude
+namespace detail
+{
+    template <typename Indexable>
+    class index_iterator
+    {
+    public:
+        using value_type        = valid_index<Indexable>;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = void;
+        using reference         = valid_index<Indexable>;
+        using iterator_category = std::input_iterator_tag;
+
+        explicit constexpr index_iterator(std::size_t index, const index_owner& owner) noexcept
+        : index_(index), owner_(owner)
+        {}
+
+        constexpr valid_index<Indexable> operator*() const noexcept
+        {
+            return valid_index<Indexable>(index_t(index_), owner_);
+        }
+
+        index_iterator& operator++() noexcept
+        {
+            ++index_;
+            return *this;
+        }
+
+        index_iterator operator++(int) noexcept
+        {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+
+        friend constexpr bool operator==(const index_iterator& a, const index_iterator& b) noexcept
+        {
+            return a.index_ == b.index_;
+        }
+
+        friend constexpr bool operator!=(const index_iterator& a, const index_iterator& b) noexcept
+        {
+            return !(a == b);
+        }
+
+        static constexpr bool is_owner(const valid_index<Indexable>& index,
+                                       const void*                    obj) noexcept
+        {
+            return index.is_owner(obj);
+        }
+
+    private:
+        std::size_t index_;
+        index_owner owner_;
+    };
 } // namespace detail
 
+/// The range of all valid indices of an object of type `Indexable`,
+/// created by [ts::indices]().
+/// \module types
+template <typename Indexable>
+class index_range
+{
+public:
+    using iterator = detail::index_iterator<Indexable>;
+
+    /// \returns An iterator to the first index.
+    constexpr iterator begin() const noexcept
+    {
+        return iterator(0u, owner_);
+    }
+
+    /// \returns An iterator one past the last index.
+    constexpr iterator end() const noexcept
+    {
+        return iterator(size_, owner_);
+    }
+
+    /// \returns The number of indices.
+    constexpr std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    /// \returns Whether or not there are no indices.
+    constexpr bool empty() const noexcept
+    {
+        return size_ == 0u;
+    }
+
+private:
+    explicit constexpr index_range(std::size_t size, const void* obj) noexcept
+    : size_(size), owner_(obj)
+    {}
+
+    std::size_t         size_;
+    detail::index_owner owner_;
+
+    template <typename T>
+    friend auto indices(T&& obj) -> index_range<detail::index_container<T>>;
+};
+
+/// \returns The range of all valid indices of `obj`,
+/// i.e. the [ts::valid_index]() from `0` to the size of `obj`.
+/// \notes The size is only determined once, when the range is created,
+/// so `obj` must not become smaller while the indices are used.
+/// \module types
+template <typename T>
+auto indices(T&& obj) -> index_range<detail::index_container<T>>
+{
+    return index_range<detail::index_container<T>>(detail::index_size(detail::member_size{}, obj),
+                                                   std::addressof(obj));
+}
+
 /// \returns The `i`th element of `obj` by invoking its `operator[]` with the [ts::index_t]()
 /// converted to `std::size_t`. \requires `index` must be a valid index for `obj`, i.e. less than
 /// the size of `obj`. \exclude return \module types
@@ -189,35 +628,93 @@ auto at(Indexable&& obj, const index_t& index)
     return std::forward<Indexable>(obj)[static_cast<std::size_t>(get(index))];
 }
 
-/// \effects Increments the [ts::index_t]() by the specified distance.
+/// \returns The `i`th element of `obj` by invoking its `operator[]` with the [ts::valid_index]()
+/// converted to `std::size_t`.
+/// \notes Unlike the other overload, it does not compare the index with the size,
+/// it has been checked when creating the [ts::indices]().
+/// It only checks that `index` belongs to `obj` by comparing their addresses.
+/// \requires `index` must be obtained from the [ts::indices]() of `obj`,
+/// and `obj` must not have become smaller since.
+/// \exclude return
+/// \module types
+template <typename Indexable>
+auto at(Indexable&& obj, const valid_index<detail::index_container<Indexable>>& index)
+    -> decltype(std::forward<Indexable>(obj)[static_cast<std::size_t>(get(index.get_index()))])
+{
+    DEBUG_ASSERT(detail::index_iterator<detail::index_container<Indexable>>::is_owner(
+                     index, std::addressof(obj)),
+                 detail::precondition_error_handler{}, "index of a different object");
+    // the object must not have become smaller, this is only an internal assertion
+    DEBUG_ASSERT(detail::index_valid(detail::member_size{}, obj,
+                                     static_cast<std::size_t>(get(index.get_index()))),
+                 detail::assert_handler{});
+    return std::forward<Indexable>(obj)[static_cast<std::size_t>(get(index.get_index()))];
+}
+
+/// \effects Increments the index by the specified distance.
 /// If the distance is negative, decrements the index instead.
 /// \notes This is the same as `index += dist` and the equivalent of [std::advance()]().
 /// \module types
+/// \group advance
+template <class Index, typename UnsignedInteger, class Difference>
+void advance(basic_index<Index, UnsignedInteger, Difference>& index, const Difference& dist)
+{
+    index += dist;
+}
+
+/// \group advance
 inline void advance(index_t& index, const difference_t& dist)
 {
     index += dist;
 }
 
-/// \returns The distance between two [ts::index_t]() objects,
+/// \returns The distance between two indices,
 /// i.e. how often you'd have to increment `a` to reach `b`.
 /// \notes This is the same as `b - a` and the equivalent of [std::distance()]().
 /// \module types
+/// \group distance
+template <class Index, typename UnsignedInteger, class Difference>
+constexpr Difference distance(const basic_index<Index, UnsignedInteger, Difference>& a,
+                              const basic_index<Index, UnsignedInteger, Difference>& b)
+{
+    return b - a;
+}
+
+/// \group distance
 constexpr difference_t distance(const index_t& a, const index_t& b)
 {
     return b - a;
 }
 
-/// \returns The [ts::index_t]() that is `dist` greater than `index`.
+/// \returns The index that is `dist` greater than `index`.
 /// \notes This is the same as `index + dist` and the equivalent of [std::next()]().
 /// \module types
+/// \group next
+template <class Index, typename UnsignedInteger, class Difference>
+constexpr Index next(const basic_index<Index, UnsignedInteger, Difference>& index,
+                     const Difference&                                      dist = Difference(1))
+{
+    return index + dist;
+}
+
+/// \group next
 constexpr index_t next(const index_t& index, const difference_t& dist = difference_t(1))
 {
     return index + dist;
 }
 
-/// \returns The [ts::index_t]() that is `dist` smaller than `index`.
+/// \returns The index that is `dist` smaller than `index`.
 /// \notes This is the same as `index - dist` and the equivalent of [std::prev()]().
 /// \module types
+/// \group prev
+template <class Index, typename UnsignedInteger, class Difference>
+constexpr Index prev(const basic_index<Index, UnsignedInteger, Difference>& index,
+                     const Difference&                                      dist = Difference(1))
+{
+    return index - dist;
+}
+
+/// \group prev
 constexpr index_t prev(const index_t& index, const difference_t& dist = difference_t(1))
 {
     return index - dist;
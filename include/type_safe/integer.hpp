@@ -11,6 +11,7 @@
 #include <type_traits>
 
 #include <type_safe/arithmetic_policy.hpp>
+#include <type_safe/boolean.hpp>
 #include <type_safe/detail/assert.hpp>
 #include <type_safe/detail/force_inline.hpp>
 
@@ -439,6 +440,19 @@ TYPE_SAFE_FORCE_INLINE constexpr integer<UnsignedInteger, Policy> abs(
     return i;
 }
 
+/// Branch-free selection of an [ts::integer]().
+/// \returns `a` if `cond` is `true`, `b` otherwise.
+/// \notes It is implemented without a conditional jump.
+/// \module types
+template <typename IntegerT, class Policy>
+TYPE_SAFE_FORCE_INLINE constexpr integer<IntegerT, Policy> select(
+    boolean cond, const integer<IntegerT, Policy>& a, const integer<IntegerT, Policy>& b) noexcept
+{
+    return integer<IntegerT, Policy>(
+        detail::select(std::true_type{}, static_cast<bool>(cond), static_cast<IntegerT>(a),
+                       static_cast<IntegerT>(b)));
+}
+
 //=== comparison ===//
 /// \exclude
 #define TYPE_SAFE_DETAIL_MAKE_OP(Op)                                                               \
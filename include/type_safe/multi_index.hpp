@@ -0,0 +1,571 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_MULTI_INDEX_HPP_INCLUDED
+#define TYPE_SAFE_MULTI_INDEX_HPP_INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include <type_safe/config.hpp>
+#include <type_safe/detail/all_of.hpp>
+#include <type_safe/detail/assert.hpp>
+#include <type_safe/detail/bit_ops.hpp>
+#include <type_safe/index.hpp>
+#include <type_safe/reference.hpp>
+
+namespace type_safe
+{
+/// A type modelling the difference between two [ts::multi_index]() objects,
+/// i.e. one [ts::difference_t]() for each of the `Rank` dimensions.
+/// \module types
+template <std::size_t Rank>
+class multi_difference
+{
+    static_assert(Rank > 0u, "rank must not be zero");
+
+public:
+    /// \returns The number of dimensions.
+    static constexpr std::size_t rank() noexcept
+    {
+        return Rank;
+    }
+
+    /// \effects Initializes all differences to `0`.
+    constexpr multi_difference() noexcept : differences_{} {}
+
+    /// \effects Initializes the difference of each dimension,
+    /// the first argument is the one of dimension `0`.
+    /// \notes This constructor does not participate in overload resolution,
+    /// unless there are `Rank` arguments that are all convertible to [ts::difference_t]().
+    /// \param 1
+    /// \exclude
+    template <typename... Differences,
+              typename = typename std::enable_if<
+                  sizeof...(Differences) == Rank
+                  && detail::all_of<
+                      std::is_convertible<Differences, difference_t>::value...>::value>::type>
+    constexpr multi_difference(const Differences&... differences) noexcept
+    : differences_{difference_t(differences)...}
+    {}
+
+    /// \returns The difference of dimension `dim`.
+    /// \requires `dim < Rank`.
+    /// \group index
+    TYPE_SAFE_CONSTEXPR14 difference_t& operator[](std::size_t dim) noexcept
+    {
+        DEBUG_ASSERT(dim < Rank, detail::precondition_error_handler{}, "dimension out of range");
+        return differences_[dim];
+    }
+
+    /// \group index
+    TYPE_SAFE_CONSTEXPR14 const difference_t& operator[](std::size_t dim) const noexcept
+    {
+        DEBUG_ASSERT(dim < Rank, detail::precondition_error_handler{}, "dimension out of range");
+        return differences_[dim];
+    }
+
+    /// \returns Whether or not the differences of all dimensions are equal.
+    friend TYPE_SAFE_CONSTEXPR14 bool operator==(const multi_difference& lhs,
+                                                 const multi_difference& rhs) noexcept
+    {
+        for (std::size_t dim = 0u; dim != Rank; ++dim)
+            if (lhs.differences_[dim] != rhs.differences_[dim])
+                return false;
+        return true;
+    }
+
+    /// \returns Whether or not the difference of any dimension is different.
+    friend TYPE_SAFE_CONSTEXPR14 bool operator!=(const multi_difference& lhs,
+                                                 const multi_difference& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    difference_t differences_[Rank];
+};
+
+/// A type modelling an index into a `Rank`-dimensional array,
+/// i.e. one [ts::index_t]() for each dimension.
+///
+/// It is linearized into an index of the memory by a layout,
+/// like [ts::layout::row_major]() or [ts::layout::morton](),
+/// which is used by [ts::multi_array_ref]().
+/// You can add and subtract a [ts::multi_difference](),
+/// this advances the index of each dimension separately.
+/// \module types
+template <std::size_t Rank>
+class multi_index
+{
+    static_assert(Rank > 0u, "rank must not be zero");
+
+public:
+    /// \returns The number of dimensions.
+    static constexpr std::size_t rank() noexcept
+    {
+        return Rank;
+    }
+
+    /// \effects Initializes all indices to `0`.
+    constexpr multi_index() noexcept : indices_{} {}
+
+    /// \effects Initializes the index of each dimension,
+    /// the first argument is the one of dimension `0`.
+    /// \notes This constructor does not participate in overload resolution,
+    /// unless there are `Rank` arguments that are all convertible to [ts::index_t]().
+    /// \param 1
+    /// \exclude
+    template <typename... Indices,
+              typename = typename std::enable_if<
+                  sizeof...(Indices) == Rank
+                  && detail::all_of<std::is_convertible<Indices, index_t>::value...>::value>::type>
+    constexpr multi_index(const Indices&... indices) noexcept : indices_{index_t(indices)...}
+    {}
+
+    /// \returns The index of dimension `dim`.
+    /// \requires `dim < Rank`.
+    /// \group index
+    TYPE_SAFE_CONSTEXPR14 index_t& operator[](std::size_t dim) noexcept
+    {
+        DEBUG_ASSERT(dim < Rank, detail::precondition_error_handler{}, "dimension out of range");
+        return indices_[dim];
+    }
+
+    /// \group index
+    TYPE_SAFE_CONSTEXPR14 const index_t& operator[](std::size_t dim) const noexcept
+    {
+        DEBUG_ASSERT(dim < Rank, detail::precondition_error_handler{}, "dimension out of range");
+        return indices_[dim];
+    }
+
+    /// \effects Advances the index of each dimension by the corresponding difference.
+    /// \requires The new indices must be greater or equal to `0`.
+    TYPE_SAFE_CONSTEXPR14 multi_index& operator+=(const multi_difference<Rank>& rhs) noexcept
+    {
+        for (std::size_t dim = 0u; dim != Rank; ++dim)
+            indices_[dim] += rhs[dim];
+        return *this;
+    }
+
+    /// \effects Advances the index of each dimension backwards by the corresponding difference.
+    /// \requires The new indices must be greater or equal to `0`.
+    TYPE_SAFE_CONSTEXPR14 multi_index& operator-=(const multi_difference<Rank>& rhs) noexcept
+    {
+        for (std::size_t dim = 0u; dim != Rank; ++dim)
+            indices_[dim] -= rhs[dim];
+        return *this;
+    }
+
+    /// \returns Whether or not the indices of all dimensions are equal.
+    friend TYPE_SAFE_CONSTEXPR14 bool operator==(const multi_index& lhs,
+                                                 const multi_index& rhs) noexcept
+    {
+        for (std::size_t dim = 0u; dim != Rank; ++dim)
+            if (lhs.indices_[dim] != rhs.indices_[dim])
+                return false;
+        return true;
+    }
+
+    /// \returns Whether or not the index of any dimension is different.
+    friend TYPE_SAFE_CONSTEXPR14 bool operator!=(const multi_index& lhs,
+                                                 const multi_index& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    index_t indices_[Rank];
+};
+
+/// \returns The given [ts::multi_index]() advanced by the given [ts::multi_difference]().
+/// \module types
+/// \group multi_index_plus
+template <std::size_t Rank>
+TYPE_SAFE_CONSTEXPR14 multi_index<Rank> operator+(multi_index<Rank>                  lhs,
+                                                  const multi_difference<Rank>& rhs) noexcept
+{
+    return lhs += rhs;
+}
+
+/// \group multi_index_plus
+template <std::size_t Rank>
+TYPE_SAFE_CONSTEXPR14 multi_index<Rank> operator+(const multi_difference<Rank>& lhs,
+                                                  multi_index<Rank>             rhs) noexcept
+{
+    return rhs += lhs;
+}
+
+/// \returns The given [ts::multi_index]() advanced backwards by the given
+/// [ts::multi_difference]().
+/// \module types
+template <std::size_t Rank>
+TYPE_SAFE_CONSTEXPR14 multi_index<Rank> operator-(multi_index<Rank>             lhs,
+                                                  const multi_difference<Rank>& rhs) noexcept
+{
+    return lhs -= rhs;
+}
+
+/// \returns The distance between two indices in each dimension.
+/// \module types
+template <std::size_t Rank>
+TYPE_SAFE_CONSTEXPR14 multi_difference<Rank> operator-(const multi_index<Rank>& lhs,
+                                                       const multi_index<Rank>& rhs) noexcept
+{
+    multi_difference<Rank> result;
+    for (std::size_t dim = 0u; dim != Rank; ++dim)
+        result[dim] = lhs[dim] - rhs[dim];
+    return result;
+}
+
+/// \exclude
+namespace detail
+{
+    template <std::size_t Rank>
+    bool multi_index_valid(const multi_index<Rank>& index, const multi_index<Rank>& extents)
+    {
+        for (std::size_t dim = 0u; dim != Rank; ++dim)
+            if (index[dim] >= extents[dim])
+                return false;
+        return true;
+    }
+
+    template <std::size_t Rank>
+    std::size_t extent(const multi_index<Rank>& extents, std::size_t dim) noexcept
+    {
+        return static_cast<std::size_t>(get(extents[dim]));
+    }
+
+    template <std::size_t Rank>
+    std::array<std::size_t, Rank> row_major_strides(const multi_index<Rank>& extents) noexcept
+    {
+        std::array<std::size_t, Rank> result;
+        std::size_t                   stride = 1u;
+        for (auto dim = Rank; dim != 0u; --dim)
+        {
+            result[dim - 1u] = stride;
+            stride *= extent(extents, dim - 1u);
+        }
+        return result;
+    }
+
+    template <std::size_t Rank>
+    std::array<std::size_t, Rank> column_major_strides(const multi_index<Rank>& extents) noexcept
+    {
+        std::array<std::size_t, Rank> result;
+        std::size_t                   stride = 1u;
+        for (std::size_t dim = 0u; dim != Rank; ++dim)
+        {
+            result[dim] = stride;
+            stride *= extent(extents, dim);
+        }
+        return result;
+    }
+} // namespace detail
+
+/// Layouts that linearize a [ts::multi_index]() into an [ts::index_t]() of the memory.
+///
+/// A layout has a static member function `rank()`, the number of dimensions,
+/// and the member functions `extents()`, returning a [ts::multi_index]() with the size of each
+/// dimension, `size()`, returning the number of elements the memory must have,
+/// and a call operator, returning the [ts::index_t]() of a [ts::multi_index]().
+/// The call operator does not check the index, this is done by [ts::multi_array_ref]().
+namespace layout
+{
+    /// A layout where the elements are at a fixed distance, the stride, in each dimension.
+    ///
+    /// It can describe a view into a part of a bigger array,
+    /// like a column of a matrix.
+    /// \module types
+    template <std::size_t Rank>
+    class strided
+    {
+    public:
+        /// \returns The number of dimensions.
+        static constexpr std::size_t rank() noexcept
+        {
+            return Rank;
+        }
+
+        /// \effects Creates a layout with the given size and stride of each dimension.
+        strided(const multi_index<Rank>& extents, const std::array<std::size_t, Rank>& strides)
+        : extents_(extents), strides_(strides)
+        {}
+
+        /// \returns The size of each dimension.
+        const multi_index<Rank>& extents() const noexcept
+        {
+            return extents_;
+        }
+
+        /// \returns The stride of each dimension.
+        const std::array<std::size_t, Rank>& strides() const noexcept
+        {
+            return strides_;
+        }
+
+        /// \returns The number of elements the memory must have,
+        /// i.e. one more than the index of the last element.
+        std::size_t size() const noexcept
+        {
+            std::size_t result = 1u;
+            for (std::size_t dim = 0u; dim != Rank; ++dim)
+            {
+                auto extent = detail::extent(extents_, dim);
+                if (extent == 0u)
+                    return 0u;
+                result += (extent - 1u) * strides_[dim];
+            }
+            return result;
+        }
+
+        /// \returns The sum of the index of each dimension multiplied with its stride.
+        index_t operator()(const multi_index<Rank>& index) const noexcept
+        {
+            std::size_t result = 0u;
+            for (std::size_t dim = 0u; dim != Rank; ++dim)
+                result += static_cast<std::size_t>(get(index[dim])) * strides_[dim];
+            return index_t(result);
+        }
+
+    private:
+        multi_index<Rank>             extents_;
+        std::array<std::size_t, Rank> strides_;
+    };
+
+    /// A [ts::layout::strided]() layout where the last dimension is contiguous,
+    /// as in a C array.
+    /// \module types
+    template <std::size_t Rank>
+    class row_major : public strided<Rank>
+    {
+    public:
+        /// \effects Creates a layout with the given size of each dimension.
+        explicit row_major(const multi_index<Rank>& extents)
+        : strided<Rank>(extents, detail::row_major_strides(extents))
+        {}
+    };
+
+    /// A [ts::layout::strided]() layout where the first dimension is contiguous,
+    /// as in a Fortran array.
+    /// \module types
+    template <std::size_t Rank>
+    class column_major : public strided<Rank>
+    {
+    public:
+        /// \effects Creates a layout with the given size of each dimension.
+        explicit column_major(const multi_index<Rank>& extents)
+        : strided<Rank>(extents, detail::column_major_strides(extents))
+        {}
+    };
+
+    /// A layout that divides the array into tiles of `TileSize` elements in each dimension.
+    ///
+    /// The elements of a tile are contiguous,
+    /// so neighbors in any dimension are usually close in memory,
+    /// unlike in [ts::layout::row_major]().
+    /// Both the tiles and the elements inside a tile are stored in row-major order.
+    /// \notes The size of each dimension is rounded up to a multiple of `TileSize`,
+    /// the elements in the padding are never accessed.
+    /// \module types
+    template <std::size_t Rank, std::size_t TileSize>
+    class tiled
+    {
+        static_assert(TileSize > 0u, "tile size must not be zero");
+
+    public:
+        /// \returns The number of dimensions.
+        static constexpr std::size_t rank() noexcept
+        {
+            return Rank;
+        }
+
+        /// \effects Creates a layout with the given size of each dimension.
+        explicit tiled(const multi_index<Rank>& extents) : extents_(extents)
+        {
+            for (std::size_t dim = 0u; dim != Rank; ++dim)
+                tiles_[dim] = (detail::extent(extents_, dim) + TileSize - 1u) / TileSize;
+        }
+
+        /// \returns The size of each dimension.
+        const multi_index<Rank>& extents() const noexcept
+        {
+            return extents_;
+        }
+
+        /// \returns The number of elements the memory must have,
+        /// i.e. the number of tiles multiplied with the number of elements in a tile.
+        std::size_t size() const noexcept
+        {
+            std::size_t result = 1u;
+            for (std::size_t dim = 0u; dim != Rank; ++dim)
+                result *= tiles_[dim] * TileSize;
+            return result;
+        }
+
+        /// \returns The index of the tile multiplied with the number of elements in a tile,
+        /// plus the index of the element inside the tile.
+        index_t operator()(const multi_index<Rank>& index) const noexcept
+        {
+            std::size_t tile = 0u, inner = 0u, tile_elements = 1u;
+            for (std::size_t dim = 0u; dim != Rank; ++dim)
+            {
+                auto i = static_cast<std::size_t>(get(index[dim]));
+                tile   = tile * tiles_[dim] + i / TileSize;
+                inner  = inner * TileSize + i % TileSize;
+                tile_elements *= TileSize;
+            }
+            return index_t(tile * tile_elements + inner);
+        }
+
+    private:
+        multi_index<Rank> extents_;
+        std::size_t       tiles_[Rank];
+    };
+
+    /// A layout that stores the elements in Z-order, or Morton order.
+    ///
+    /// The index is obtained by interleaving the bits of the indices of all dimensions,
+    /// the lowest bit belongs to the last dimension.
+    /// Like [ts::layout::tiled](), it keeps neighbors close in memory,
+    /// but on all scales.
+    /// The bits are interleaved using the `pdep` instruction if BMI2 is available.
+    /// \notes The memory is as big as a cube whose size is the biggest size of all dimensions,
+    /// rounded up to a power of two,
+    /// so it is only suitable for arrays whose dimensions are roughly equal.
+    /// \module types
+    template <std::size_t Rank>
+    class morton
+    {
+    public:
+        /// \returns The number of dimensions.
+        static constexpr std::size_t rank() noexcept
+        {
+            return Rank;
+        }
+
+        /// \effects Creates a layout with the given size of each dimension.
+        /// \requires The index of each element must fit into a [ts::size_t]().
+        explicit morton(const multi_index<Rank>& extents) : extents_(extents), bits_(0u)
+        {
+            std::size_t max = 0u;
+            for (std::size_t dim = 0u; dim != Rank; ++dim)
+                if (detail::extent(extents_, dim) > max)
+                    max = detail::extent(extents_, dim);
+            while (bits_ < std::numeric_limits<std::size_t>::digits
+                   && (std::size_t(1u) << bits_) < max)
+                ++bits_;
+            DEBUG_ASSERT(Rank * bits_ < std::numeric_limits<std::size_t>::digits,
+                         detail::precondition_error_handler{}, "array too big for Morton order");
+
+            for (std::size_t dim = 0u; dim != Rank; ++dim)
+            {
+                masks_[dim] = 0u;
+                for (std::size_t bit = 0u; bit != bits_; ++bit)
+                    masks_[dim] |= std::uint_least64_t(1u) << (bit * Rank + Rank - 1u - dim);
+            }
+        }
+
+        /// \returns The size of each dimension.
+        const multi_index<Rank>& extents() const noexcept
+        {
+            return extents_;
+        }
+
+        /// \returns The number of elements the memory must have.
+        std::size_t size() const noexcept
+        {
+            for (std::size_t dim = 0u; dim != Rank; ++dim)
+                if (detail::extent(extents_, dim) == 0u)
+                    return 0u;
+            return std::size_t(1u) << (Rank * bits_);
+        }
+
+        /// \returns The bits of the indices of all dimensions interleaved.
+        index_t operator()(const multi_index<Rank>& index) const noexcept
+        {
+            std::uint_least64_t result = 0u;
+            for (std::size_t dim = 0u; dim != Rank; ++dim)
+                result |= detail::deposit_bits(static_cast<std::size_t>(get(index[dim])),
+                                               masks_[dim]);
+            return index_t(static_cast<std::size_t>(result));
+        }
+
+    private:
+        multi_index<Rank>   extents_;
+        std::uint_least64_t masks_[Rank];
+        std::size_t         bits_;
+    };
+} // namespace layout
+
+/// A reference to a `Rank`-dimensional array of `T` that is stored in memory using the `Layout`.
+///
+/// It is indexed by a [ts::multi_index](),
+/// which is checked against the size of each dimension and linearized by the layout.
+/// With a [ts::layout::strided]() layout it is a strided view of an [ts::array_ref]().
+/// \requires `Layout` must be a layout as described in [ts::layout]().
+/// \module types
+template <typename T, class Layout>
+class multi_array_ref
+{
+public:
+    using value_type  = T;
+    using layout_type = Layout;
+    using index_type  = multi_index<Layout::rank()>;
+
+    /// \effects Creates a reference to the memory `[data, data + layout.size())`.
+    /// \requires `data` must not be `nullptr` unless `layout.size()` is `0`.
+    multi_array_ref(T* data, Layout layout) noexcept : data_(data), layout_(std::move(layout))
+    {
+        DEBUG_ASSERT(data_ || layout_.size() == 0u, detail::precondition_error_handler{},
+                     "invalid array");
+    }
+
+    /// \effects Creates a reference to the memory of the `array`.
+    /// \requires The `array` must have at least `layout.size()` elements.
+    multi_array_ref(array_ref<T> array, Layout layout) noexcept
+    : data_(array.data()), layout_(std::move(layout))
+    {
+        DEBUG_ASSERT(static_cast<std::size_t>(array.size()) >= layout_.size(),
+                     detail::precondition_error_handler{}, "array too small for layout");
+    }
+
+    /// \returns A pointer to the memory.
+    T* data() const noexcept
+    {
+        return data_;
+    }
+
+    /// \returns The layout.
+    const Layout& layout() const noexcept
+    {
+        return layout_;
+    }
+
+    /// \returns The size of each dimension.
+    const index_type& extents() const noexcept
+    {
+        return layout_.extents();
+    }
+
+    /// \returns A reference to the element at the given index.
+    /// \requires The index of each dimension must be less than its size.
+    T& operator[](const index_type& index) const noexcept
+    {
+        DEBUG_ASSERT(detail::multi_index_valid(index, extents()),
+                     detail::precondition_error_handler{}, "index out of bounds");
+        return data_[static_cast<std::size_t>(get(layout_(index)))];
+    }
+
+private:
+    T*     data_;
+    Layout layout_;
+};
+} // namespace type_safe
+
+#endif // TYPE_SAFE_MULTI_INDEX_HPP_INCLUDED
@@ -0,0 +1,566 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_ORDERED_VECTOR_HPP_INCLUDED
+#define TYPE_SAFE_ORDERED_VECTOR_HPP_INCLUDED
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <type_safe/constrained_type.hpp>
+#include <type_safe/detail/assert.hpp>
+
+namespace type_safe
+{
+namespace constraints
+{
+    /// A `Constraint` for the [ts::constrained_type]().
+    ///
+    /// A container is valid if its elements are sorted according to `Compare`.
+    template <typename T, class Compare = std::less<T>>
+    class sorted
+    {
+    public:
+        sorted() : comp_() {}
+
+        explicit sorted(Compare comp) : comp_(std::move(comp)) {}
+
+        template <class Container>
+        bool operator()(const Container& c) const
+        {
+            return std::is_sorted(std::begin(c), std::end(c), comp_);
+        }
+
+    private:
+        Compare comp_;
+    };
+
+    /// A `Constraint` for the [ts::constrained_type]().
+    ///
+    /// A container is valid if its elements are sorted according to `Compare`,
+    /// and no two elements are equivalent.
+    template <typename T, class Compare = std::less<T>>
+    class sorted_unique
+    {
+    public:
+        sorted_unique() : comp_() {}
+
+        explicit sorted_unique(Compare comp) : comp_(std::move(comp)) {}
+
+        template <class Container>
+        bool operator()(const Container& c) const
+        {
+            auto& comp = comp_;
+            // the next element must be strictly greater
+            return std::adjacent_find(std::begin(c), std::end(c),
+                                      [&](const T& a, const T& b) { return !comp(a, b); })
+                   == std::end(c);
+        }
+
+    private:
+        Compare comp_;
+    };
+
+    /// A `Constraint` for the [ts::constrained_type]().
+    ///
+    /// A container is valid if its elements form a heap according to `Compare`,
+    /// like created by [std::make_heap]().
+    template <typename T, class Compare = std::less<T>>
+    class heap
+    {
+    public:
+        heap() : comp_() {}
+
+        explicit heap(Compare comp) : comp_(std::move(comp)) {}
+
+        template <class Container>
+        bool operator()(const Container& c) const
+        {
+            return std::is_heap(std::begin(c), std::end(c), comp_);
+        }
+
+    private:
+        Compare comp_;
+    };
+} // namespace constraints
+
+/// A [std::vector]() whose elements are always sorted according to `Compare`.
+///
+/// If `Unique` is `true`, it also never contains two equivalent elements.
+/// Unlike a [ts::constrained_type]() of a vector with [ts::constraints::sorted](),
+/// the modifiers maintain the order directly,
+/// so they never need to verify the entire vector.
+/// In turn, it provides lookups using binary search and a linear merge.
+/// \notes It only provides `const` access to the elements,
+/// as modifying them could break the order.
+template <typename T, class Compare, bool Unique>
+class basic_sorted_vector
+{
+    using vector = std::vector<T>;
+
+public:
+    using value_type     = T;
+    using value_compare  = Compare;
+    using iterator       = typename vector::const_iterator;
+    using const_iterator = iterator;
+    using size_type      = typename vector::size_type;
+    using constraint_predicate =
+        typename std::conditional<Unique, constraints::sorted_unique<T, Compare>,
+                                  constraints::sorted<T, Compare>>::type;
+
+    //=== constructors ===//
+    /// \effects Creates an empty vector.
+    explicit basic_sorted_vector(Compare comp = {}) : comp_(std::move(comp)) {}
+
+    /// \effects Creates it from the elements of `values`, which will be sorted.
+    /// If `Unique` is `true`, only the first of equivalent elements is kept.
+    explicit basic_sorted_vector(vector values, Compare comp = {})
+    : comp_(std::move(comp)), vec_(std::move(values))
+    {
+        std::stable_sort(vec_.begin(), vec_.end(), value_comp());
+        erase_duplicates();
+    }
+
+    /// \effects Creates it from the elements of `values`, which are assumed to be sorted already.
+    /// They are only verified if [TYPE_SAFE_ENABLE_ASSERTIONS]() or
+    /// [TYPE_SAFE_ENABLE_AUDIT_CHECKS]() is `true`.
+    /// \requires `values` must fulfill the `constraint_predicate`.
+    basic_sorted_vector(assume_valid_t, vector values, Compare comp = {})
+    : comp_(std::move(comp)), vec_(std::move(values))
+    {
+        DEBUG_ASSERT(get_constraint()(vec_), detail::audit_handler{},
+                     "values assumed to be sorted are not");
+    }
+
+    //=== observers ===//
+    /// \returns The comparison function.
+    const value_compare& value_comp() const noexcept
+    {
+        return comp_;
+    }
+
+    /// \returns The predicate the elements fulfill.
+    constraint_predicate get_constraint() const
+    {
+        return constraint_predicate(value_comp());
+    }
+
+    /// \returns A `const` reference to the underlying vector.
+    const vector& get_vector() const noexcept
+    {
+        return vec_;
+    }
+
+    /// \effects Moves the underlying vector out,
+    /// it will not be sorted any further.
+    /// \returns An rvalue reference to the underlying vector.
+    /// \notes After this function is called, the object must not be used anymore
+    /// except as target for assignment or in the destructor.
+    vector&& release() TYPE_SAFE_RVALUE_REF noexcept
+    {
+        return std::move(vec_);
+    }
+
+    //=== access ===//
+    iterator begin() const noexcept
+    {
+        return vec_.begin();
+    }
+
+    iterator end() const noexcept
+    {
+        return vec_.end();
+    }
+
+    bool empty() const noexcept
+    {
+        return vec_.empty();
+    }
+
+    size_type size() const noexcept
+    {
+        return vec_.size();
+    }
+
+    /// \returns The smallest element.
+    /// \requires The vector must not be empty.
+    const T& front() const noexcept
+    {
+        DEBUG_ASSERT(!empty(), detail::precondition_error_handler{}, "empty vector");
+        return vec_.front();
+    }
+
+    /// \returns The greatest element.
+    /// \requires The vector must not be empty.
+    const T& back() const noexcept
+    {
+        DEBUG_ASSERT(!empty(), detail::precondition_error_handler{}, "empty vector");
+        return vec_.back();
+    }
+
+    //=== lookup ===//
+    /// \returns An iterator to the first element not less than `value`,
+    /// found in `O(log n)`.
+    iterator lower_bound(const T& value) const
+    {
+        return std::lower_bound(vec_.begin(), vec_.end(), value, value_comp());
+    }
+
+    /// \returns An iterator to the first element greater than `value`,
+    /// found in `O(log n)`.
+    iterator upper_bound(const T& value) const
+    {
+        return std::upper_bound(vec_.begin(), vec_.end(), value, value_comp());
+    }
+
+    /// \returns The range of elements equivalent to `value`,
+    /// found in `O(log n)`.
+    std::pair<iterator, iterator> equal_range(const T& value) const
+    {
+        return std::equal_range(vec_.begin(), vec_.end(), value, value_comp());
+    }
+
+    /// \returns An iterator to an element equivalent to `value` or `end()` if there is none,
+    /// found in `O(log n)`.
+    iterator find(const T& value) const
+    {
+        auto iter = lower_bound(value);
+        return iter != end() && !value_comp()(value, *iter) ? iter : end();
+    }
+
+    /// \returns Whether or not there is an element equivalent to `value`,
+    /// found in `O(log n)`.
+    bool contains(const T& value) const
+    {
+        return std::binary_search(vec_.begin(), vec_.end(), value, value_comp());
+    }
+
+    /// \returns The number of elements equivalent to `value`,
+    /// found in `O(log n)`.
+    size_type count(const T& value) const
+    {
+        auto range = equal_range(value);
+        return static_cast<size_type>(range.second - range.first);
+    }
+
+    //=== modifiers ===//
+    /// \effects Inserts `value` at its position,
+    /// after all equivalent elements.
+    /// If `Unique` is `true` and there is an equivalent element already, does nothing.
+    /// \returns A pair of an iterator to the inserted or equivalent element,
+    /// and whether or not `value` was inserted.
+    /// \notes The position is found in `O(log n)`,
+    /// but moving the following elements is `O(n)`.
+    /// \group insert
+    std::pair<iterator, bool> insert(const T& value)
+    {
+        return insert_impl(value);
+    }
+
+    /// \group insert
+    std::pair<iterator, bool> insert(T&& value)
+    {
+        return insert_impl(std::move(value));
+    }
+
+    /// \effects Inserts all elements in the range `[first, last)`,
+    /// by sorting them and merging them with the existing elements,
+    /// in `O(n + k log k)` for `k` new elements.
+    /// \group insert
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        auto old_size = vec_.size();
+        vec_.insert(vec_.end(), first, last);
+        std::stable_sort(vec_.begin() + static_cast<typename vector::difference_type>(old_size),
+                         vec_.end(), value_comp());
+        merge_tail(old_size);
+    }
+
+    /// \effects Merges all elements of `other` into this one in `O(n + m)`,
+    /// as both are sorted already.
+    void merge(const basic_sorted_vector& other)
+    {
+        auto old_size = vec_.size();
+        vec_.insert(vec_.end(), other.begin(), other.end());
+        merge_tail(old_size);
+    }
+
+    /// \effects Erases the element at the given position, the order is not changed.
+    /// \returns An iterator after the erased element.
+    /// \group erase
+    iterator erase(iterator pos)
+    {
+        return vec_.erase(pos);
+    }
+
+    /// \effects Erases the elements in the range `[first, last)`, the order is not changed.
+    /// \returns An iterator after the erased elements.
+    /// \group erase
+    iterator erase(iterator first, iterator last)
+    {
+        return vec_.erase(first, last);
+    }
+
+    /// \effects Erases all elements equivalent to `value`.
+    /// \returns The number of erased elements.
+    /// \group erase
+    size_type erase(const T& value)
+    {
+        auto range = equal_range(value);
+        auto count = static_cast<size_type>(range.second - range.first);
+        vec_.erase(range.first, range.second);
+        return count;
+    }
+
+    /// \effects Erases all elements.
+    void clear() noexcept
+    {
+        vec_.clear();
+    }
+
+    /// \effects Reserves memory for `size` elements.
+    void reserve(size_type size)
+    {
+        vec_.reserve(size);
+    }
+
+private:
+    template <typename U>
+    std::pair<iterator, bool> insert_impl(U&& value)
+    {
+        if (Unique)
+        {
+            auto pos = lower_bound(value);
+            if (pos != end() && !value_comp()(value, *pos))
+                return std::make_pair(pos, false);
+            return std::make_pair(vec_.insert(pos, std::forward<U>(value)), true);
+        }
+        else
+            return std::make_pair(vec_.insert(upper_bound(value), std::forward<U>(value)), true);
+    }
+
+    // merges the sorted elements starting at old_size with the sorted ones before
+    void merge_tail(size_type old_size)
+    {
+        std::inplace_merge(vec_.begin(),
+                           vec_.begin() + static_cast<typename vector::difference_type>(old_size),
+                           vec_.end(), value_comp());
+        erase_duplicates();
+    }
+
+    void erase_duplicates()
+    {
+        if (!Unique)
+            return;
+
+        auto& comp = value_comp();
+        vec_.erase(std::unique(vec_.begin(), vec_.end(),
+                               [&](const T& a, const T& b) { return !comp(a, b); }),
+                   vec_.end());
+    }
+
+    Compare comp_;
+    vector  vec_;
+};
+
+/// A [ts::basic_sorted_vector]() that may contain equivalent elements.
+template <typename T, class Compare = std::less<T>>
+using sorted_vector = basic_sorted_vector<T, Compare, false>;
+
+/// A [ts::basic_sorted_vector]() that never contains equivalent elements.
+template <typename T, class Compare = std::less<T>>
+using sorted_unique_vector = basic_sorted_vector<T, Compare, true>;
+
+/// \returns Whether or not there is an element equivalent to `value` in `vec`,
+/// found in `O(log n)` as the vector is known to be sorted.
+template <typename T, class Compare, bool Unique>
+bool binary_search(const basic_sorted_vector<T, Compare, Unique>& vec, const T& value)
+{
+    return vec.contains(value);
+}
+
+/// \returns A vector containing the elements of `lhs` and `rhs`,
+/// merged in `O(n + m)` as both are known to be sorted.
+/// If `Unique` is `true`, it contains the elements of both without duplicates.
+template <typename T, class Compare, bool Unique>
+basic_sorted_vector<T, Compare, Unique> merge(const basic_sorted_vector<T, Compare, Unique>& lhs,
+                                              const basic_sorted_vector<T, Compare, Unique>& rhs)
+{
+    std::vector<T> result;
+    result.reserve(lhs.size() + rhs.size());
+    if (Unique)
+        std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(result),
+                       lhs.value_comp());
+    else
+        std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(result),
+                   lhs.value_comp());
+    return basic_sorted_vector<T, Compare, Unique>(assume_valid, std::move(result),
+                                                   lhs.value_comp());
+}
+
+/// A [std::vector]() whose elements always form a heap according to `Compare`.
+///
+/// The greatest element is on top and can be accessed in `O(1)`,
+/// elements are inserted and the top one is removed in `O(log n)`.
+/// Unlike a [ts::constrained_type]() of a vector with [ts::constraints::heap](),
+/// the modifiers maintain the heap property directly,
+/// so they never need to verify the entire vector.
+/// \notes It only provides `const` access to the elements,
+/// as modifying them could break the heap property.
+template <typename T, class Compare = std::less<T>>
+class heap_vector
+{
+    using vector = std::vector<T>;
+
+public:
+    using value_type           = T;
+    using value_compare        = Compare;
+    using iterator             = typename vector::const_iterator;
+    using const_iterator       = iterator;
+    using size_type            = typename vector::size_type;
+    using constraint_predicate = constraints::heap<T, Compare>;
+
+    //=== constructors ===//
+    /// \effects Creates an empty heap.
+    explicit heap_vector(Compare comp = {}) : comp_(std::move(comp)) {}
+
+    /// \effects Creates it from the elements of `values` in `O(n)`.
+    explicit heap_vector(vector values, Compare comp = {})
+    : comp_(std::move(comp)), vec_(std::move(values))
+    {
+        std::make_heap(vec_.begin(), vec_.end(), value_comp());
+    }
+
+    /// \effects Creates it from the elements of `values`, which are assumed to form a heap already.
+    /// They are only verified if [TYPE_SAFE_ENABLE_ASSERTIONS]() or
+    /// [TYPE_SAFE_ENABLE_AUDIT_CHECKS]() is `true`.
+    /// \requires `values` must fulfill the `constraint_predicate`.
+    heap_vector(assume_valid_t, vector values, Compare comp = {})
+    : comp_(std::move(comp)), vec_(std::move(values))
+    {
+        DEBUG_ASSERT(get_constraint()(vec_), detail::audit_handler{},
+                     "values assumed to be a heap are not");
+    }
+
+    //=== observers ===//
+    /// \returns The comparison function.
+    const value_compare& value_comp() const noexcept
+    {
+        return comp_;
+    }
+
+    /// \returns The predicate the elements fulfill.
+    constraint_predicate get_constraint() const
+    {
+        return constraint_predicate(value_comp());
+    }
+
+    /// \returns A `const` reference to the underlying vector.
+    const vector& get_vector() const noexcept
+    {
+        return vec_;
+    }
+
+    /// \effects Moves the underlying vector out,
+    /// it will not be a heap any further.
+    /// \returns An rvalue reference to the underlying vector.
+    /// \notes After this function is called, the object must not be used anymore
+    /// except as target for assignment or in the destructor.
+    vector&& release() TYPE_SAFE_RVALUE_REF noexcept
+    {
+        return std::move(vec_);
+    }
+
+    /// \effects Sorts the elements in `O(n log n)` using the heap.
+    /// \returns A [ts::sorted_vector]() of the elements, which isn't sorted again.
+    /// \notes After this function is called, the object must not be used anymore
+    /// except as target for assignment or in the destructor.
+    sorted_vector<T, Compare> sort() TYPE_SAFE_RVALUE_REF
+    {
+        std::sort_heap(vec_.begin(), vec_.end(), value_comp());
+        return sorted_vector<T, Compare>(assume_valid, std::move(vec_), value_comp());
+    }
+
+    //=== access ===//
+    /// \returns An iterator to the beginning of the elements, in heap order.
+    iterator begin() const noexcept
+    {
+        return vec_.begin();
+    }
+
+    /// \returns An iterator to the end of the elements, in heap order.
+    iterator end() const noexcept
+    {
+        return vec_.end();
+    }
+
+    bool empty() const noexcept
+    {
+        return vec_.empty();
+    }
+
+    size_type size() const noexcept
+    {
+        return vec_.size();
+    }
+
+    /// \returns The greatest element.
+    /// \requires The heap must not be empty.
+    const T& top() const noexcept
+    {
+        DEBUG_ASSERT(!empty(), detail::precondition_error_handler{}, "empty heap");
+        return vec_.front();
+    }
+
+    //=== modifiers ===//
+    /// \effects Inserts `value` in `O(log n)`.
+    /// \group push
+    void push(const T& value)
+    {
+        vec_.push_back(value);
+        std::push_heap(vec_.begin(), vec_.end(), value_comp());
+    }
+
+    /// \group push
+    void push(T&& value)
+    {
+        vec_.push_back(std::move(value));
+        std::push_heap(vec_.begin(), vec_.end(), value_comp());
+    }
+
+    /// \effects Removes the greatest element in `O(log n)`.
+    /// \returns The removed element.
+    /// \requires The heap must not be empty.
+    T pop()
+    {
+        DEBUG_ASSERT(!empty(), detail::precondition_error_handler{}, "empty heap");
+        std::pop_heap(vec_.begin(), vec_.end(), value_comp());
+        auto result = std::move(vec_.back());
+        vec_.pop_back();
+        return result;
+    }
+
+    /// \effects Erases all elements.
+    void clear() noexcept
+    {
+        vec_.clear();
+    }
+
+    /// \effects Reserves memory for `size` elements.
+    void reserve(size_type size)
+    {
+        vec_.reserve(size);
+    }
+
+private:
+    Compare comp_;
+    vector  vec_;
+};
+} // namespace type_safe
+
+#endif // TYPE_SAFE_ORDERED_VECTOR_HPP_INCLUDED
@@ -0,0 +1,135 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_PARALLEL_HPP_INCLUDED
+#define TYPE_SAFE_PARALLEL_HPP_INCLUDED
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <type_safe/array_view.hpp>
+#include <type_safe/config.hpp>
+#include <type_safe/reference.hpp>
+
+namespace type_safe
+{
+/// \exclude
+namespace detail
+{
+    // the slices of parallel_for_each() are about as big as a typical L1 cache
+    constexpr std::size_t parallel_chunk_bytes = 32u * 1024u;
+
+    template <typename T>
+    constexpr std::size_t parallel_chunk_size() noexcept
+    {
+        return sizeof(T) < parallel_chunk_bytes ? parallel_chunk_bytes / sizeof(T) : 1u;
+    }
+
+    class parallel_error
+    {
+    public:
+        parallel_error() noexcept : failed_(false) {}
+
+        bool failed() const noexcept
+        {
+            return failed_.load(std::memory_order_relaxed);
+        }
+
+        void set(std::exception_ptr error) noexcept
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!error_)
+                error_ = std::move(error);
+            failed_.store(true, std::memory_order_relaxed);
+        }
+
+        void rethrow()
+        {
+            if (error_)
+                std::rethrow_exception(error_);
+        }
+
+    private:
+        std::mutex         mutex_;
+        std::exception_ptr error_;
+        std::atomic<bool>  failed_;
+    };
+
+    // processes slices until there are none left,
+    // every worker takes the next one, so faster workers process more of them
+    template <typename T, bool XValue, typename Func>
+    void parallel_worker(const chunk_range<T, XValue>& range, std::atomic<std::size_t>& next,
+                         parallel_error& error, Func& f) noexcept
+    {
+        TYPE_SAFE_TRY
+        {
+            for (auto i = next.fetch_add(1u, std::memory_order_relaxed);
+                 i < static_cast<std::size_t>(range.size()) && !error.failed();
+                 i = next.fetch_add(1u, std::memory_order_relaxed))
+                for (auto&& elem : range[index_t(i)])
+                    f(std::forward<decltype(elem)>(elem));
+        }
+        TYPE_SAFE_CATCH_ALL
+        {
+            error.set(std::current_exception());
+        }
+    }
+} // namespace detail
+
+/// \effects Invokes `f` for every element of the array,
+/// passing it an (`rvalue` if `XValue` is `true`) reference to the element.
+/// The array is split into [ts::chunks]() of `chunk_size` elements,
+/// which are processed by `threads` threads, including the calling one.
+/// Every thread takes the next slice that hasn't been processed yet,
+/// so the load is balanced even if some elements take longer.
+/// \throws The first exception thrown by `f`, after all threads have finished.
+/// The remaining slices are not processed then.
+/// \requires `f` must be safe to invoke concurrently for different elements.
+/// \notes By default a slice has about 32KiB and there is one thread per core.
+/// \notes The threads are created for each call,
+/// so it is only worth it for arrays of many elements.
+/// The program must be linked with the threading library of the platform.
+template <typename T, bool XValue, typename Func>
+void parallel_for_each(const array_ref<T, XValue>& ref, Func&& f,
+                       size_t       chunk_size = detail::parallel_chunk_size<T>(),
+                       unsigned int threads    = std::thread::hardware_concurrency())
+{
+    chunk_range<T, XValue> range(ref, chunk_size);
+    if (threads == 0u)
+        threads = 1u;
+    auto slices = static_cast<std::size_t>(range.size());
+    if (slices < threads)
+        threads = static_cast<unsigned int>(slices);
+
+    std::atomic<std::size_t> next(0u);
+    detail::parallel_error   error;
+
+    std::vector<std::thread> workers;
+    if (threads > 1u)
+    {
+        workers.reserve(threads - 1u);
+        TYPE_SAFE_TRY
+        {
+            for (auto i = 1u; i != threads; ++i)
+                workers.emplace_back([&] { detail::parallel_worker(range, next, error, f); });
+        }
+        TYPE_SAFE_CATCH_ALL
+        {
+            // couldn't create a thread, process the slices with the ones that exist
+        }
+    }
+    detail::parallel_worker(range, next, error, f);
+
+    for (auto& worker : workers)
+        worker.join();
+    error.rethrow();
+}
+} // namespace type_safe
+
+#endif // TYPE_SAFE_PARALLEL_HPP_INCLUDED
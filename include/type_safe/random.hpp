@@ -0,0 +1,261 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_RANDOM_HPP_INCLUDED
+#define TYPE_SAFE_RANDOM_HPP_INCLUDED
+
+#include <cstdint>
+#include <type_traits>
+
+#include <type_safe/bounded_type.hpp>
+#include <type_safe/detail/assert.hpp>
+#include <type_safe/detail/bit_ops.hpp>
+#include <type_safe/index.hpp>
+#include <type_safe/reference.hpp>
+
+namespace type_safe
+{
+/// \exclude
+namespace detail
+{
+    // the number of values in a range and the rejection threshold of Lemire's method,
+    // a range of 0 means all values of W
+    template <typename W>
+    struct random_range
+    {
+        W range;
+        W threshold;
+    };
+
+    template <typename W>
+    constexpr random_range<W> make_random_range(W range) noexcept
+    {
+        return {range, range == 0u ? W(0u) : W(W(W(0u) - range) % range)};
+    }
+
+    template <typename W>
+    struct random_interval
+    {
+        std::uintmax_t   min;
+        random_range<W> range;
+    };
+
+    // the word type used to draw values of T
+    template <typename T>
+    using random_word = typename std::conditional<sizeof(T) <= sizeof(std::uint_least32_t),
+                                                  std::uint_least32_t, std::uint_least64_t>::type;
+
+    template <class Generator>
+    struct random_generator_bits
+    {
+        static_assert(Generator::min() == 0u, "generator must start at 0");
+        static_assert(Generator::max() == 0xFFFFFFFFu || Generator::max() == 0xFFFFFFFFFFFFFFFFu,
+                      "generator must produce 32 or 64 uniformly random bits");
+
+        static constexpr bool is_64 = Generator::max() > 0xFFFFFFFFu;
+    };
+
+    template <class Generator>
+    std::uint_least32_t draw_bits(Generator& gen, std::uint_least32_t*) noexcept(noexcept(gen()))
+    {
+        return random_generator_bits<Generator>::is_64
+                   // use the high bits
+                   ? static_cast<std::uint_least32_t>(std::uint_least64_t(gen()) >> 32)
+                   : static_cast<std::uint_least32_t>(gen());
+    }
+
+    template <class Generator>
+    std::uint_least64_t draw_bits(Generator& gen, std::uint_least64_t*) noexcept(noexcept(gen()))
+    {
+        if (random_generator_bits<Generator>::is_64)
+            return static_cast<std::uint_least64_t>(gen());
+        auto high = std::uint_least64_t(gen()) << 32;
+        return high | std::uint_least64_t(gen());
+    }
+
+    inline std::uint_least32_t multiply_wide(std::uint_least32_t a, std::uint_least32_t b,
+                                             std::uint_least32_t& low) noexcept
+    {
+        auto product = std::uint_least64_t(a) * b;
+        low          = static_cast<std::uint_least32_t>(product);
+        return static_cast<std::uint_least32_t>(product >> 32);
+    }
+
+    // Lemire's multiply-shift rejection sampling:
+    // the high half of the product of a random word and the range is uniform in [0, range),
+    // if products whose low half is less than the threshold are rejected
+    template <typename W, class Generator>
+    W draw_uniform(Generator& gen, const random_range<W>& r) noexcept(noexcept(gen()))
+    {
+        auto x = draw_bits(gen, static_cast<W*>(nullptr));
+        if (r.range == 0u)
+            return x;
+
+        W low;
+        W high = multiply_wide(x, r.range, low);
+        while (low < r.threshold)
+        {
+            x    = draw_bits(gen, static_cast<W*>(nullptr));
+            high = multiply_wide(x, r.range, low);
+        }
+        return high;
+    }
+
+    template <typename T, bool LowerInclusive, bool UpperInclusive, typename LowerBound,
+              typename UpperBound>
+    struct static_random_interval
+    {
+        using word = random_word<T>;
+
+        static constexpr std::uintmax_t min = static_cast<std::uintmax_t>(
+            T(LowerInclusive ? LowerBound::value : LowerBound::value + 1));
+        static constexpr std::uintmax_t max = static_cast<std::uintmax_t>(
+            T(UpperInclusive ? UpperBound::value : UpperBound::value - 1));
+
+        static constexpr word range     = make_random_range(word(max - min + 1u)).range;
+        static constexpr word threshold = make_random_range(word(max - min + 1u)).threshold;
+    };
+
+    // static bounds, everything is computed at compile-time
+    template <typename T, bool LowerInclusive, bool UpperInclusive, typename LowerBound,
+              typename UpperBound>
+    random_interval<random_word<T>> make_random_interval(
+        std::false_type,
+        const constraints::bounded<T, LowerInclusive, UpperInclusive, LowerBound, UpperBound>&)
+    {
+        using interval
+            = static_random_interval<T, LowerInclusive, UpperInclusive, LowerBound, UpperBound>;
+        return {interval::min, {interval::range, interval::threshold}};
+    }
+
+    // (partially) dynamic bounds
+    template <typename T, bool LowerInclusive, bool UpperInclusive, typename LowerBound,
+              typename UpperBound>
+    random_interval<random_word<T>> make_random_interval(
+        std::true_type,
+        const constraints::bounded<T, LowerInclusive, UpperInclusive, LowerBound, UpperBound>&
+            bounds)
+    {
+        auto lower = static_cast<T>(bounds.get_lower_bound());
+        auto upper = static_cast<T>(bounds.get_upper_bound());
+        DEBUG_ASSERT(LowerInclusive && UpperInclusive ? lower <= upper : lower < upper,
+                     precondition_error_handler{}, "empty interval");
+
+        auto min = static_cast<std::uintmax_t>(LowerInclusive ? lower : T(lower + 1));
+        auto max = static_cast<std::uintmax_t>(UpperInclusive ? upper : T(upper - 1));
+        return {min, make_random_range(random_word<T>(max - min + 1u))};
+    }
+
+    template <typename T, bool LowerInclusive, bool UpperInclusive, typename LowerBound,
+              typename UpperBound>
+    random_interval<random_word<T>> make_random_interval(
+        const constraints::bounded<T, LowerInclusive, UpperInclusive, LowerBound, UpperBound>&
+            bounds)
+    {
+        static_assert(std::is_integral<T>::value, "only integral types are supported");
+        using is_dynamic = std::integral_constant<
+            bool, constraints::detail::is_dynamic<LowerBound>::value
+                      || constraints::detail::is_dynamic<UpperBound>::value>;
+        return make_random_interval(is_dynamic{}, bounds);
+    }
+} // namespace detail
+
+/// An adaptor for a random number generator that produces uniformly distributed
+/// [ts::bounded_type](), [ts::clamped_type]() and [ts::index_t]() values.
+///
+/// It uses Lemire's multiply-shift rejection sampling, which is unbiased,
+/// unlike `gen() % range`, and faster than [std::uniform_int_distribution]():
+/// it requires one multiplication and no division per value.
+/// The rejection threshold for static bounds is computed at compile-time,
+/// and the bulk [*fill]() computes it only once for dynamic bounds.
+/// The results are the same for every standard library.
+/// \requires `Generator` must be a `UniformRandomBitGenerator` with `min() == 0`
+/// and `max()` either `2^32 - 1` or `2^64 - 1`, like [std::mt19937]() and [std::mt19937_64]().
+/// \module types
+template <class Generator>
+class bounded_random
+{
+public:
+    /// \effects Creates it using the given generator.
+    /// \notes It stores a reference to the generator,
+    /// so the generator must live as long as it is used.
+    explicit bounded_random(Generator& gen) noexcept : gen_(&gen) {}
+
+    /// \returns A reference to the generator.
+    Generator& generator() const noexcept
+    {
+        return *gen_;
+    }
+
+    /// \returns A uniformly distributed value of `Bounded` in the interval of `bounds`.
+    /// \requires `Bounded` must be a [ts::bounded_type](), [ts::clamped_type]() or
+    /// [ts::compact_bounded_type]() of an integral type.
+    /// The default argument is only available for static bounds.
+    template <class Bounded>
+    Bounded generate(const typename Bounded::constraint_predicate& bounds = {})
+    {
+        return draw<Bounded>(detail::make_random_interval(bounds), bounds);
+    }
+
+    /// \returns A uniformly distributed index in the range `[0, size)`.
+    /// \requires `size` must not be `0`.
+    index_t index(size_t size)
+    {
+        DEBUG_ASSERT(size != 0u, detail::precondition_error_handler{}, "empty range");
+        return index_t(static_cast<std::size_t>(
+            detail::draw_uniform(*gen_, index_range(static_cast<std::size_t>(size)))));
+    }
+
+    /// \effects Assigns a uniformly distributed value in the interval of `bounds` to each
+    /// element of `out`.
+    /// \requires `Bounded` must be a [ts::bounded_type](), [ts::clamped_type]() or
+    /// [ts::compact_bounded_type]() of an integral type.
+    /// The default argument is only available for static bounds.
+    template <class Bounded>
+    void fill(array_ref<Bounded> out, const typename Bounded::constraint_predicate& bounds = {})
+    {
+        auto interval = detail::make_random_interval(bounds);
+        for (auto cur = out.data(); cur != out.data() + static_cast<std::size_t>(out.size()); ++cur)
+            *cur = draw<Bounded>(interval, bounds);
+    }
+
+    /// \effects Assigns a uniformly distributed index in the range `[0, size)` to each element of
+    /// `out`.
+    /// \requires `size` must not be `0`.
+    void fill(array_ref<index_t> out, size_t size)
+    {
+        DEBUG_ASSERT(size != 0u, detail::precondition_error_handler{}, "empty range");
+        auto range = index_range(static_cast<std::size_t>(size));
+        for (auto cur = out.data(); cur != out.data() + static_cast<std::size_t>(out.size()); ++cur)
+            *cur = index_t(static_cast<std::size_t>(detail::draw_uniform(*gen_, range)));
+    }
+
+private:
+    static detail::random_range<detail::random_word<std::size_t>> index_range(
+        std::size_t size) noexcept
+    {
+        return detail::make_random_range(detail::random_word<std::size_t>(size));
+    }
+
+    template <class Bounded, typename W>
+    Bounded draw(const detail::random_interval<W>&                 interval,
+                 const typename Bounded::constraint_predicate& bounds)
+    {
+        using value_type = typename Bounded::value_type;
+        auto offset      = detail::draw_uniform(*gen_, interval.range);
+        return Bounded(static_cast<value_type>(interval.min + offset), bounds);
+    }
+
+    Generator* gen_;
+};
+
+/// \returns A [ts::bounded_random]() using the given generator.
+template <class Generator>
+bounded_random<Generator> make_bounded_random(Generator& gen) noexcept
+{
+    return bounded_random<Generator>(gen);
+}
+} // namespace type_safe
+
+#endif // TYPE_SAFE_RANDOM_HPP_INCLUDED
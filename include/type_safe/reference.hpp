@@ -5,12 +5,15 @@
 #ifndef TYPE_SAFE_REFERENCE_HPP_INCLUDED
 #define TYPE_SAFE_REFERENCE_HPP_INCLUDED
 
+#include <cstdint>
 #include <new>
 #include <type_traits>
 #include <utility>
 
 #include <type_safe/detail/aligned_union.hpp>
+#include <type_safe/detail/all_of.hpp>
 #include <type_safe/detail/assert.hpp>
+#include <type_safe/detail/force_inline.hpp>
 #include <type_safe/detail/map_invoke.hpp>
 #include <type_safe/index.hpp>
 
@@ -387,6 +390,43 @@ public:
         return static_cast<reference_type>(at(begin_, i));
     }
 
+    /// \returns A reference to the first `count` elements of the array.
+    /// \requires `count <= size()`.
+    array_ref first(size_t count) const noexcept
+    {
+        DEBUG_ASSERT(count <= size_, detail::precondition_error_handler{},
+                     "out of bounds array access");
+        return array_ref(begin_, count);
+    }
+
+    /// \returns A reference to the last `count` elements of the array.
+    /// \requires `count <= size()`.
+    array_ref last(size_t count) const noexcept
+    {
+        DEBUG_ASSERT(count <= size_, detail::precondition_error_handler{},
+                     "out of bounds array access");
+        return array_ref(end() - static_cast<std::size_t>(count), count);
+    }
+
+    /// \returns A reference to the elements starting at `offset`,
+    /// either `count` elements or all the remaining ones.
+    /// \requires `offset <= size()` and `offset + count <= size()`.
+    /// \group subspan
+    array_ref subspan(size_t offset) const noexcept
+    {
+        DEBUG_ASSERT(offset <= size_, detail::precondition_error_handler{},
+                     "out of bounds array access");
+        return array_ref(begin_ + static_cast<std::size_t>(offset), size_ - offset);
+    }
+
+    /// \group subspan
+    array_ref subspan(size_t offset, size_t count) const noexcept
+    {
+        DEBUG_ASSERT(offset <= size_ && count <= size_ - offset,
+                     detail::precondition_error_handler{}, "out of bounds array access");
+        return array_ref(begin_ + static_cast<std::size_t>(offset), count);
+    }
+
 private:
     T*     begin_;
     size_t size_;
@@ -477,6 +517,217 @@ array_xvalue_ref<T> xref(T* array, size_t size) noexcept
     return array_xvalue_ref<T>(array, size);
 }
 
+/// A reference to an array of exactly `Extent` objects of type `T`.
+///
+/// It is like [ts::array_ref](), but the size is a compile-time constant,
+/// so it is only a pointer and loops over it have a known trip count,
+/// which allows the compiler to unroll and vectorize them completely.
+/// It converts implicitly to [ts::array_ref]().
+/// \notes `T` is the type stored in the array,
+/// `XValue` has the same meaning as in [ts::array_ref]().
+template <typename T, std::size_t Extent, bool XValue = false>
+class fixed_array_ref
+{
+    static_assert(!std::is_void<T>::value, "must not be void");
+    static_assert(!std::is_reference<T>::value, "pass the type without reference");
+    static_assert(!XValue || !std::is_const<T>::value, "must not be const if xvalue reference");
+    static_assert(Extent != 0u, "use array_ref for empty arrays");
+
+public:
+    using value_type     = T;
+    using reference_type = typename std::conditional<XValue, T&&, T&>::type;
+    using iterator       = T*;
+
+    /// \effects Sets the reference to the memory range `[array, array + Extent)`.
+    /// \requires `array` must not be `nullptr`.
+    /// \notes This constructor only participates in overload resolution if `U` is `T`,
+    /// it is a template so that C arrays use the other constructor.
+    /// \param 1
+    /// \exclude
+    template <typename U, typename = typename std::enable_if<std::is_same<U, T>::value>::type>
+    explicit fixed_array_ref(U* array) noexcept : begin_(array)
+    {
+        DEBUG_ASSERT(array, detail::precondition_error_handler{}, "invalid array bounds");
+    }
+
+    /// \effects Sets the reference to the C array.
+    explicit fixed_array_ref(T (&arr)[Extent]) noexcept : begin_(arr) {}
+
+    /// \effects Sets the reference to the same array as `ref`.
+    /// \requires `ref.size() == Extent`.
+    explicit fixed_array_ref(const array_ref<T, XValue>& ref) noexcept : begin_(ref.data())
+    {
+        DEBUG_ASSERT(ref.size() == Extent, detail::precondition_error_handler{},
+                     "array has the wrong size");
+    }
+
+    /// \returns An [ts::array_ref]() to the same array.
+    operator array_ref<T, XValue>() const noexcept
+    {
+        return array_ref<T, XValue>(begin_, Extent);
+    }
+
+    /// \returns An iterator to the beginning of the array.
+    iterator begin() const noexcept
+    {
+        return begin_;
+    }
+
+    /// \returns An iterator one past the last element of the array.
+    iterator end() const noexcept
+    {
+        return begin_ + Extent;
+    }
+
+    /// \returns A pointer to the beginning of the array.
+    T* data() const noexcept
+    {
+        return begin_;
+    }
+
+    /// \returns The number of elements in the array, which is `Extent`.
+    static constexpr size_t size() noexcept
+    {
+        return Extent;
+    }
+
+    /// \returns A (`rvalue` if `Xvalue` is `true`) reference to the `i`th element of the array.
+    /// \requires `i < Extent`.
+    reference_type operator[](index_t i) const noexcept
+    {
+        DEBUG_ASSERT(static_cast<std::size_t>(get(i)) < Extent,
+                     detail::precondition_error_handler{}, "out of bounds array access");
+        return static_cast<reference_type>(begin_[static_cast<std::size_t>(get(i))]);
+    }
+
+private:
+    T* begin_;
+};
+
+/// With operation for [ts::fixed_array_ref]().
+/// \effects Same as the one for [ts::array_ref]().
+template <typename T, std::size_t Extent, bool XValue, typename Func, typename... Args>
+void with(const fixed_array_ref<T, Extent, XValue>& ref, Func&& f, Args&&... additional_args)
+{
+    for (auto&& elem : ref)
+        f(std::forward<decltype(elem)>(elem), additional_args...);
+}
+
+/// \exclude
+namespace detail
+{
+    template <std::size_t Align, typename T>
+    TYPE_SAFE_FORCE_INLINE T* assume_aligned(T* ptr) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<T*>(__builtin_assume_aligned(ptr, Align));
+#elif defined(_MSC_VER)
+        __assume((reinterpret_cast<std::uintptr_t>(ptr) & (Align - 1u)) == 0u);
+        return ptr;
+#else
+        return ptr;
+#endif
+    }
+
+    template <std::size_t Align, typename T>
+    bool is_aligned(T* ptr) noexcept
+    {
+        return reinterpret_cast<std::uintptr_t>(ptr) % Align == 0u;
+    }
+} // namespace detail
+
+/// A reference to an array of objects of type `T` whose first element is aligned to `Align`.
+///
+/// It is like [ts::array_ref](),
+/// but every pointer it returns tells the compiler about the alignment,
+/// so a vectorized loop over it does not need a prologue for the unaligned elements.
+/// \requires `Align` must be a power of two and a multiple of `alignof(T)`.
+/// \notes `T` is the type stored in the array,
+/// `XValue` has the same meaning as in [ts::array_ref]().
+template <typename T, std::size_t Align, bool XValue = false>
+class aligned_array_ref
+{
+    static_assert((Align & (Align - 1u)) == 0u, "alignment must be a power of two");
+    static_assert(Align % alignof(T) == 0u, "alignment must be a multiple of the type's");
+
+public:
+    using value_type     = T;
+    using reference_type = typename std::conditional<XValue, T&&, T&>::type;
+    using iterator       = T*;
+
+    /// \effects Sets the reference to the memory range `[array, array + size)`.
+    /// \requires `array` must not be `nullptr` unless `size` is `0`,
+    /// and it must be aligned to `Align`.
+    aligned_array_ref(T* array, size_t size) noexcept : ref_(array, size)
+    {
+        DEBUG_ASSERT(detail::is_aligned<Align>(array), detail::precondition_error_handler{},
+                     "array is not aligned");
+    }
+
+    /// \effects Sets the reference to the same array as `ref`.
+    /// \requires `ref.data()` must be aligned to `Align`.
+    explicit aligned_array_ref(const array_ref<T, XValue>& ref) noexcept : ref_(ref)
+    {
+        DEBUG_ASSERT(detail::is_aligned<Align>(ref.data()), detail::precondition_error_handler{},
+                     "array is not aligned");
+    }
+
+    /// \returns An [ts::array_ref]() to the same array.
+    operator const array_ref<T, XValue>&() const noexcept
+    {
+        return ref_;
+    }
+
+    /// \returns An iterator to the beginning of the array,
+    /// the compiler can assume that it is aligned.
+    iterator begin() const noexcept
+    {
+        return data();
+    }
+
+    /// \returns An iterator one past the last element of the array.
+    iterator end() const noexcept
+    {
+        return data() + static_cast<std::size_t>(size());
+    }
+
+    /// \returns A pointer to the beginning of the array,
+    /// the compiler can assume that it is aligned.
+    T* data() const noexcept
+    {
+        return detail::assume_aligned<Align>(ref_.data());
+    }
+
+    /// \returns The number of elements in the array.
+    size_t size() const noexcept
+    {
+        return ref_.size();
+    }
+
+    /// \returns A (`rvalue` if `Xvalue` is `true`) reference to the `i`th element of the array.
+    /// \requires `i < size()`.
+    /// \notes The element is accessed through [*data](),
+    /// so the compiler can assume that the array is aligned.
+    reference_type operator[](index_t i) const noexcept
+    {
+        DEBUG_ASSERT(static_cast<std::size_t>(get(i)) < static_cast<std::size_t>(size()),
+                     detail::precondition_error_handler{}, "out of bounds array access");
+        return static_cast<reference_type>(data()[static_cast<std::size_t>(get(i))]);
+    }
+
+private:
+    array_ref<T, XValue> ref_;
+};
+
+/// With operation for [ts::aligned_array_ref]().
+/// \effects Same as the one for [ts::array_ref]().
+template <typename T, std::size_t Align, bool XValue, typename Func, typename... Args>
+void with(const aligned_array_ref<T, Align, XValue>& ref, Func&& f, Args&&... additional_args)
+{
+    for (auto&& elem : ref)
+        f(std::forward<decltype(elem)>(elem), additional_args...);
+}
+
 /// \exclude
 namespace detail
 {
@@ -486,16 +737,26 @@ namespace detail
                                        || std::is_convertible<Returned, Required>::value>
     {};
 
-    // can't use template alias, GCC 4.8 gets confused
     template <typename Func, typename Return, typename... Args>
-    struct enable_matching_function
+    struct is_matching_function
     {
-        using type = typename std::enable_if<
-            compatible_return_type<decltype(std::declval<Func&>()(std::declval<Args>()...)),
-                                   Return>::value,
-            int>::type;
+        // the call expression must be in the immediate context, otherwise it is a hard error
+        template <typename F>
+        static auto test(int) -> compatible_return_type<
+            decltype(std::declval<F&>()(std::declval<Args>()...)), Return>;
+
+        template <typename F>
+        static std::false_type test(...);
+
+        using type = decltype(test<Func>(0));
     };
 
+    // can't use template alias, GCC 4.8 gets confused
+    template <typename Func, typename Return, typename... Args>
+    struct enable_matching_function
+    : std::enable_if<is_matching_function<Func, Return, Args...>::type::value, int>
+    {};
+
     struct matching_function_pointer_tag
     {};
     struct matching_functor_tag
@@ -528,7 +789,7 @@ namespace detail
         int>::type;
 } // namespace detail
 
-template <typename Signature>
+template <typename... Signatures>
 class function_ref;
 
 /// A reference to a function.
@@ -638,27 +899,30 @@ public:
     }
 
     /// \effects Invokes the stored function with the specified arguments and returns the result.
+    /// \notes The arguments are forwarded by reference to the stored function,
+    /// so a by-value parameter is only copied once, into the parameter of this function,
+    /// and then moved once into the parameter of the stored function.
     Return operator()(Args... args) const
     {
-        return cb_(get_memory(), static_cast<Args>(args)...);
+        return cb_(get_memory(), static_cast<Args&&>(args)...);
     }
 
 private:
     template <typename Functor>
-    static Return invoke_functor(const void* memory, Args... args)
+    static Return invoke_functor(const void* memory, Args&&... args)
     {
         using ptr_t   = void*;
         ptr_t    ptr  = *static_cast<const ptr_t*>(memory);
         Functor& func = *static_cast<Functor*>(ptr);
-        return static_cast<Return>(func(static_cast<Args>(args)...));
+        return static_cast<Return>(func(static_cast<Args&&>(args)...));
     }
 
     template <typename PointerT, typename StoredT>
-    static Return invoke_function_pointer(const void* memory, Args... args)
+    static Return invoke_function_pointer(const void* memory, Args&&... args)
     {
         auto ptr  = *static_cast<const StoredT*>(memory);
         auto func = reinterpret_cast<PointerT>(ptr);
-        return static_cast<Return>(func(static_cast<Args>(args)...));
+        return static_cast<Return>(func(static_cast<Args&&>(args)...));
     }
 
     template <typename Return2, typename... Args2>
@@ -685,11 +949,138 @@ private:
     }
 
     using storage  = detail::aligned_union_t<void*, Return (*)(Args...)>;
-    using callback = Return (*)(const void*, Args...);
+    using callback = Return (*)(const void*, Args&&...);
 
     storage  storage_;
     callback cb_;
 };
+
+/// \exclude
+namespace detail
+{
+    using erased_function = void (*)();
+
+    template <typename Functor, typename Signature>
+    struct function_thunk;
+
+    template <typename Functor, typename Return, typename... Args>
+    struct function_thunk<Functor, Return(Args...)>
+    {
+        static Return invoke(const void* object, Args&&... args)
+        {
+            auto& func = *static_cast<Functor*>(const_cast<void*>(object));
+            return static_cast<Return>(func(static_cast<Args&&>(args)...));
+        }
+    };
+
+    // one thunk per signature, shared by all references to the same functor type
+    template <typename Functor, typename... Signatures>
+    struct function_table
+    {
+        static const erased_function value[sizeof...(Signatures)];
+    };
+
+    template <typename Functor, typename... Signatures>
+    const erased_function function_table<Functor, Signatures...>::value[sizeof...(Signatures)]
+        = {reinterpret_cast<erased_function>(&function_thunk<Functor, Signatures>::invoke)...};
+
+    template <typename Functor, typename Signature>
+    struct matches_signature;
+
+    template <typename Functor, typename Return, typename... Args>
+    struct matches_signature<Functor, Return(Args...)>
+    : is_matching_function<Functor, Return, Args...>::type
+    {};
+
+    struct multi_function_storage
+    {
+        const void*            object_;
+        const erased_function* table_;
+    };
+
+    // provides the call operator for the signature at index I and inherits the others
+    template <std::size_t I, typename... Signatures>
+    class multi_function_call;
+
+    template <std::size_t I, typename Return, typename... Args>
+    class multi_function_call<I, Return(Args...)> : protected multi_function_storage
+    {
+    public:
+        Return operator()(Args... args) const
+        {
+            auto thunk = reinterpret_cast<Return (*)(const void*, Args&&...)>(table_[I]);
+            return thunk(object_, static_cast<Args&&>(args)...);
+        }
+    };
+
+    template <std::size_t I, typename Return, typename... Args, typename... Rest>
+    class multi_function_call<I, Return(Args...), Rest...>
+    : public multi_function_call<I + 1u, Rest...>
+    {
+    public:
+        using multi_function_call<I + 1u, Rest...>::operator();
+
+        Return operator()(Args... args) const
+        {
+            auto thunk = reinterpret_cast<Return (*)(const void*, Args&&...)>(this->table_[I]);
+            return thunk(this->object_, static_cast<Args&&>(args)...);
+        }
+    };
+} // namespace detail
+
+/// A reference to a function object with multiple signatures.
+///
+/// It is like [ts::function_ref](),
+/// but the referred function object must be compatible with all of the `Signatures`,
+/// and it has one call operator for each of them,
+/// so it can be used as a type-erased visitor, for example.
+/// It only stores a pointer to the function object and
+/// a pointer to a static table with one entry per signature,
+/// which is shared by all references to functions of the same type,
+/// so it has the size of two pointers regardless of the number of signatures.
+/// \notes Overload resolution between the call operators happens as usual,
+/// so the signatures should not be ambiguous for the intended arguments.
+/// \notes It cannot refer to plain function pointers,
+/// use an object with the appropriate overloaded call operators.
+template <typename... Signatures>
+class function_ref : public detail::multi_function_call<0u, Signatures...>
+{
+    static_assert(sizeof...(Signatures) > 1u, "use function_ref<Signature> for one signature");
+
+public:
+    /// \effects Creates a reference to the specified functor.
+    /// It will store a pointer to the function object,
+    /// so it must live as long as the reference.
+    /// \notes This constructor does not participate in overload resolution,
+    /// unless the functor is compatible with all of the signatures.
+    /// \param 1
+    /// \exclude
+    template <typename Functor,
+              typename = typename std::enable_if<
+                  !std::is_same<typename std::remove_cv<Functor>::type, function_ref>::value
+                  && detail::all_of<
+                      detail::matches_signature<Functor, Signatures>::value...>::value>::type>
+    explicit function_ref(Functor& f) noexcept
+    {
+        this->object_ = &f;
+        this->table_  = detail::function_table<Functor, Signatures...>::value;
+    }
+
+    /// \effects Rebinds the reference to the specified functor.
+    /// \notes This function does not participate in overload resolution,
+    /// unless the functor is compatible with all of the signatures.
+    /// \param 1
+    /// \exclude
+    template <typename Functor,
+              typename = typename std::enable_if<
+                  !std::is_same<typename std::remove_cv<Functor>::type, function_ref>::value
+                  && detail::all_of<
+                      detail::matches_signature<Functor, Signatures>::value...>::value>::type>
+    void assign(Functor& f) noexcept
+    {
+        *this = function_ref(f);
+    }
+};
 } // namespace type_safe
 
 #endif // TYPE_SAFE_REFERENCE_HPP_INCLUDED
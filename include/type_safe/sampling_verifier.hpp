@@ -0,0 +1,105 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_SAMPLING_VERIFIER_HPP_INCLUDED
+#define TYPE_SAFE_SAMPLING_VERIFIER_HPP_INCLUDED
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include <type_safe/config.hpp>
+
+namespace type_safe
+{
+/// \exclude
+namespace detail
+{
+    static_assert(TYPE_SAFE_SAMPLING_RATE > 0, "sampling rate must not be zero");
+
+    using sampling_violation_handler = void (*)();
+
+    inline std::atomic<std::uint_least64_t>& sampling_violation_count() noexcept
+    {
+        static std::atomic<std::uint_least64_t> count(0u);
+        return count;
+    }
+
+    inline std::atomic<sampling_violation_handler>& sampling_handler() noexcept
+    {
+        static std::atomic<sampling_violation_handler> handler(nullptr);
+        return handler;
+    }
+
+    // returns true for every TYPE_SAFE_SAMPLING_RATE-th call of the thread
+    inline bool sample_verification() noexcept
+    {
+        static thread_local std::uint_least32_t counter = 0u;
+        if (++counter != TYPE_SAFE_SAMPLING_RATE)
+            return false;
+        counter = 0u;
+        return true;
+    }
+
+    inline void on_sampled_violation()
+    {
+        sampling_violation_count().fetch_add(1u, std::memory_order_relaxed);
+        if (auto handler = sampling_handler().load(std::memory_order_acquire))
+            handler();
+    }
+} // namespace detail
+
+/// A `Verifier` for [ts::constrained_type]() that only verifies a sample of the values.
+///
+/// It checks one in [TYPE_SAFE_SAMPLING_RATE]() values, counted per thread,
+/// and returns the value unchanged.
+/// Only the values passed to the constructors and assignment operators
+/// and the ones changed through `modify()` are counted and checked,
+/// accessing the stored value does not verify it again.
+/// A violation does not abort:
+/// it is counted, see [*violation_count](), and reported to the handler set with
+/// [*set_violation_handler](), if any.
+/// \notes This is meant for keeping precondition checks in production on hot paths,
+/// where the full cost of [ts::assertion_verifier]() is too high,
+/// but [ts::null_verifier]() would give no coverage at all.
+/// \output_section Constrained type
+struct sampling_verifier
+{
+    /// The type of the violation handler.
+    using violation_handler = detail::sampling_violation_handler;
+
+    /// \exclude
+    static constexpr bool verify_on_access = false;
+
+    template <typename Value, typename Predicate>
+    static auto verify(Value&& val, const Predicate& p) -> typename std::decay<Value>::type
+    {
+        if (detail::sample_verification() && !p(val))
+            detail::on_sampled_violation();
+        return std::forward<Value>(val);
+    }
+
+    /// \returns The number of violations detected so far, in all threads.
+    static std::uint_least64_t violation_count() noexcept
+    {
+        return detail::sampling_violation_count().load(std::memory_order_relaxed);
+    }
+
+    /// \effects Sets the function that is called for every violation detected,
+    /// `nullptr` means the violation is only counted, which is the default.
+    /// \returns The previous handler.
+    /// \notes The handler is called in the thread that detected the violation,
+    /// it may throw an exception to report it,
+    /// which is then propagated out of the constructor or assignment operator.
+    /// If it is thrown out of the destructor of a [ts::constrained_modifier](),
+    /// that must not be during stack unwinding.
+    static violation_handler set_violation_handler(violation_handler handler) noexcept
+    {
+        return detail::sampling_handler().exchange(handler, std::memory_order_acq_rel);
+    }
+};
+} // namespace type_safe
+
+#endif // TYPE_SAFE_SAMPLING_VERIFIER_HPP_INCLUDED
@@ -0,0 +1,227 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_SMALL_FUNCTION_HPP_INCLUDED
+#define TYPE_SAFE_SMALL_FUNCTION_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <type_safe/detail/assert.hpp>
+#include <type_safe/reference.hpp>
+
+namespace type_safe
+{
+/// \exclude
+namespace detail
+{
+    template <typename Return, typename... Args>
+    struct small_function_vtable
+    {
+        Return (*invoke)(void*, Args&&...);
+        // both are nullptr if the functor is trivially copyable
+        void (*move)(void* dest, void* src);
+        void (*destroy)(void* memory);
+    };
+
+    template <typename Functor, typename Return, typename... Args>
+    struct small_function_impl
+    {
+        static Return invoke(void* memory, Args&&... args)
+        {
+            return static_cast<Return>(
+                (*static_cast<Functor*>(memory))(static_cast<Args&&>(args)...));
+        }
+
+        static void move(void* dest, void* src)
+        {
+            ::new (dest) Functor(std::move(*static_cast<Functor*>(src)));
+            destroy(src);
+        }
+
+        static void destroy(void* memory)
+        {
+            static_cast<Functor*>(memory)->~Functor();
+        }
+
+#if defined(__GNUC__) && __GNUC__ < 5
+        // does not have is_trivially_copyable
+        static constexpr bool trivial = std::is_trivial<Functor>::value;
+#else
+        static constexpr bool trivial = std::is_trivially_copyable<Functor>::value
+                                        && std::is_trivially_destructible<Functor>::value;
+#endif
+
+        static constexpr small_function_vtable<Return, Args...> vtable
+            = {&invoke, trivial ? nullptr : &move, trivial ? nullptr : &destroy};
+    };
+
+    template <typename Functor, typename Return, typename... Args>
+    constexpr small_function_vtable<Return, Args...>
+        small_function_impl<Functor, Return, Args...>::vtable;
+
+    template <typename Functor>
+    bool is_null_callable(const Functor&) noexcept
+    {
+        return false;
+    }
+
+    template <typename Return, typename... Args>
+    bool is_null_callable(Return (*fptr)(Args...)) noexcept
+    {
+        return fptr == nullptr;
+    }
+} // namespace detail
+
+template <typename Signature, std::size_t Size = 3 * sizeof(void*)>
+class small_function;
+
+/// An owning function object that stores the function inside a buffer of `Size` bytes.
+///
+/// It can store any function that is compatible with the signature,
+/// with the same rules as [ts::function_ref]().
+/// Unlike [std::function]() it never allocates memory:
+/// if the function object does not fit into the buffer, it is a compile-time error.
+/// It is move-only, so it can store move-only function objects,
+/// and moving it never throws.
+/// \notes The function object is invoked as non-`const` lvalue.
+/// \requires The function object must be nothrow move constructible,
+/// and its alignment must not be greater than `alignof(std::max_align_t)`.
+template <typename Return, typename... Args, std::size_t Size>
+class small_function<Return(Args...), Size>
+{
+public:
+    using signature = Return(Args...);
+
+    //=== constructors/assignment/destructor ===//
+    /// \effects Creates an empty function.
+    /// \group empty
+    small_function() noexcept : vtable_(nullptr) {}
+
+    /// \group empty
+    small_function(std::nullptr_t) noexcept : small_function() {}
+
+    /// \effects Stores a copy of the function object or function pointer `f`,
+    /// by moving it if it is an rvalue.
+    /// \notes This constructor does not participate in overload resolution,
+    /// unless `f` is compatible with the specified signature.
+    /// \requires `f` must not be a null function pointer.
+    /// \param 1
+    /// \exclude
+    template <typename Functor,
+              typename = typename std::enable_if<
+                  !std::is_same<typename std::decay<Functor>::type, small_function>::value
+                  && !std::is_same<typename detail::get_callable_tag<
+                                       typename std::decay<Functor>::type, Return, Args...>::type,
+                                   detail::invalid_functor_tag>::value>::type>
+    small_function(Functor&& f) noexcept(
+        std::is_nothrow_constructible<typename std::decay<Functor>::type, Functor&&>::value)
+    : vtable_(nullptr)
+    {
+        using functor = typename std::decay<Functor>::type;
+        static_assert(sizeof(functor) <= Size,
+                      "function object does not fit into the buffer, increase the size");
+        static_assert(alignof(functor) <= alignof(std::max_align_t),
+                      "over-aligned function objects are not supported");
+        static_assert(std::is_nothrow_move_constructible<functor>::value,
+                      "function object must be nothrow move constructible");
+        DEBUG_ASSERT(!detail::is_null_callable(f), detail::precondition_error_handler{},
+                     "function pointer must not be null");
+
+        ::new (get_memory()) functor(std::forward<Functor>(f));
+        vtable_ = &detail::small_function_impl<functor, Return, Args...>::vtable;
+    }
+
+    /// \effects Moves the function stored in `other` into `*this`,
+    /// `other` is empty afterwards.
+    small_function(small_function&& other) noexcept : vtable_(nullptr)
+    {
+        move_from(other);
+    }
+
+    small_function(const small_function&) = delete;
+
+    /// \effects Destroys the stored function, if any.
+    ~small_function() noexcept
+    {
+        reset();
+    }
+
+    /// \effects Destroys the stored function and moves the one of `other` into `*this`,
+    /// `other` is empty afterwards.
+    small_function& operator=(small_function&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            move_from(other);
+        }
+        return *this;
+    }
+
+    small_function& operator=(const small_function&) = delete;
+
+    /// \effects Destroys the stored function, if any.
+    /// \group reset
+    small_function& operator=(std::nullptr_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    /// \group reset
+    void reset() noexcept
+    {
+        if (vtable_ && vtable_->destroy)
+            vtable_->destroy(get_memory());
+        vtable_ = nullptr;
+    }
+
+    //=== observers ===//
+    /// \returns Whether or not it stores a function.
+    explicit operator bool() const noexcept
+    {
+        return vtable_ != nullptr;
+    }
+
+    /// \effects Invokes the stored function with the specified arguments and returns the result.
+    /// \requires It must store a function.
+    Return operator()(Args... args)
+    {
+        DEBUG_ASSERT(vtable_ != nullptr, detail::precondition_error_handler{},
+                     "invoking empty small_function");
+        return vtable_->invoke(get_memory(), static_cast<Args&&>(args)...);
+    }
+
+private:
+    void move_from(small_function& other) noexcept
+    {
+        if (!other.vtable_)
+            return;
+        else if (other.vtable_->move)
+            other.vtable_->move(get_memory(), other.get_memory());
+        else
+            std::memcpy(get_memory(), other.get_memory(), Size);
+
+        vtable_       = other.vtable_;
+        other.vtable_ = nullptr;
+    }
+
+    void* get_memory() noexcept
+    {
+        return &storage_;
+    }
+
+    using vtable  = detail::small_function_vtable<Return, Args...>;
+    using storage = typename std::aligned_storage<Size, alignof(std::max_align_t)>::type;
+
+    storage       storage_;
+    const vtable* vtable_;
+};
+} // namespace type_safe
+
+#endif // TYPE_SAFE_SMALL_FUNCTION_HPP_INCLUDED
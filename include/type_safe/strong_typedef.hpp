@@ -10,6 +10,7 @@
 #include <type_traits>
 #include <utility>
 
+#include <type_safe/boolean.hpp>
 #include <type_safe/config.hpp>
 #include <type_safe/detail/all_of.hpp>
 
@@ -772,6 +773,23 @@ namespace strong_typedef_op
 #undef TYPE_SAFE_DETAIL_MAKE_STRONG_TYPEDEF_OP
 } // namespace strong_typedef_op
 
+/// Branch-free selection of a [ts::strong_typedef]().
+/// \returns `a` if `cond` is `true`, `b` otherwise.
+/// \notes It forwards to `select()` of the underlying type,
+/// so it is implemented without a conditional jump.
+/// \notes This function does not participate in overload resolution,
+/// unless `StrongTypedef` is a [ts::strong_typedef]() whose underlying type can be selected.
+/// \param 3
+/// \exclude
+template <class StrongTypedef,
+          typename = typename std::enable_if<
+              strong_typedef_op::detail::is_strong_typedef<StrongTypedef>::value>::type>
+constexpr auto select(boolean cond, const StrongTypedef& a, const StrongTypedef& b) noexcept
+    -> decltype(StrongTypedef(select(cond, get(a), get(b))))
+{
+    return StrongTypedef(select(cond, get(a), get(b)));
+}
+
 /// Inherit from it in the `std::hash<StrongTypedef>` specialization to make
 /// it hashable like the underlying type. See example/strong_typedef.cpp.
 template <class StrongTypedef>
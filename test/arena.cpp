@@ -0,0 +1,172 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/arena.hpp>
+
+#include <catch.hpp>
+
+#include <string>
+
+using namespace type_safe;
+
+namespace
+{
+struct tracked
+{
+    static int alive;
+
+    int value;
+
+    explicit tracked(int v) : value(v)
+    {
+        if (v < 0)
+            throw v;
+        ++alive;
+    }
+
+    ~tracked()
+    {
+        --alive;
+    }
+};
+
+int tracked::alive = 0;
+
+struct point
+{
+    int x, y;
+};
+
+struct first_base
+{
+    virtual ~first_base() = default;
+    int value             = 0;
+};
+
+struct second_base
+{
+    virtual ~second_base() = default;
+};
+
+// second_base is not at offset zero
+struct derived : first_base, second_base
+{
+    tracked member{0};
+    char    padding[100];
+};
+} // namespace
+
+TEST_CASE("arena")
+{
+    tracked::alive = 0;
+
+    SECTION("create/destroy")
+    {
+        arena a;
+        REQUIRE(a.block_count() == 0u);
+
+        owner<point*> p = a.create<point>(point{1, 2});
+        REQUIRE(p.get_value()->x == 1);
+        REQUIRE(p.get_value()->y == 2);
+        REQUIRE(a.block_count() == 1u);
+
+        auto t = a.create<tracked>(42);
+        REQUIRE(tracked::alive == 1);
+        REQUIRE(borrow(t)->value == 42);
+
+        a.destroy(t);
+        REQUIRE(tracked::alive == 0);
+
+        // memory of destroyed object is reused
+        auto t2 = a.create<tracked>(43);
+        REQUIRE(t2.get_value() == t.get_value());
+        REQUIRE(tracked::alive == 1);
+
+        auto q = a.create<point>(point{3, 4});
+        a.destroy(q);
+        auto q2 = a.create<point>(point{5, 6});
+        REQUIRE(q2.get_value() == q.get_value());
+    }
+    SECTION("reset")
+    {
+        arena a(256u);
+        for (auto i = 0; i != 100; ++i)
+        {
+            a.create<tracked>(i);
+            a.create<std::string>("a string that doesn't fit into the small buffer");
+        }
+        REQUIRE(tracked::alive == 100);
+        REQUIRE(a.block_count() > 1u);
+
+        a.reset();
+        REQUIRE(tracked::alive == 0);
+        REQUIRE(a.block_count() == 1u);
+
+        a.create<tracked>(0);
+        REQUIRE(tracked::alive == 1);
+        REQUIRE(a.block_count() == 1u);
+    }
+    SECTION("destructor")
+    {
+        {
+            arena a;
+            auto  t1 = a.create<tracked>(1);
+            a.create<tracked>(2);
+            a.create<tracked>(3);
+            a.destroy(t1);
+            REQUIRE(tracked::alive == 2);
+        }
+        REQUIRE(tracked::alive == 0);
+    }
+    SECTION("exception")
+    {
+        arena a;
+        REQUIRE_THROWS_AS(a.create<tracked>(-1), int);
+        REQUIRE(tracked::alive == 0);
+
+        a.create<tracked>(1);
+        a.reset();
+        REQUIRE(tracked::alive == 0);
+    }
+    SECTION("base class")
+    {
+        arena a;
+        auto  d = a.create<derived>();
+        REQUIRE(tracked::alive == 1);
+
+        owner<second_base*> b(d.get_value());
+        REQUIRE(static_cast<void*>(b.get_value()) != static_cast<void*>(d.get_value()));
+        a.destroy(b);
+        REQUIRE(tracked::alive == 0);
+
+        // memory is reused for an object of the same size
+        auto d2 = a.create<derived>();
+        REQUIRE(d2.get_value() == d.get_value());
+        a.destroy(d2);
+        REQUIRE(tracked::alive == 0);
+    }
+    SECTION("large object")
+    {
+        struct large
+        {
+            char data[1024];
+        };
+
+        arena a(64u);
+        auto  l = a.create<large>();
+        l.get_value()->data[1023] = 'a';
+        a.destroy(l);
+        REQUIRE(a.block_count() == 1u);
+    }
+    SECTION("this_thread_arena")
+    {
+        auto& a = this_thread_arena();
+        REQUIRE(&a == &this_thread_arena());
+
+        auto t = a.create<tracked>(1);
+        REQUIRE(tracked::alive == 1);
+        a.destroy(t);
+        REQUIRE(tracked::alive == 0);
+    }
+}
@@ -0,0 +1,116 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/array_view.hpp>
+
+#include <catch.hpp>
+
+#include <vector>
+
+using namespace type_safe;
+
+TEST_CASE("array_ref slices")
+{
+    int            array[5] = {1, 2, 3, 4, 5};
+    array_ref<int> ref(array);
+
+    auto first = ref.first(2u);
+    REQUIRE(first.data() == array);
+    REQUIRE((first.size() == 2u));
+
+    auto last = ref.last(2u);
+    REQUIRE(last.data() == array + 3);
+    REQUIRE((last.size() == 2u));
+
+    auto sub = ref.subspan(1u);
+    REQUIRE(sub.data() == array + 1);
+    REQUIRE((sub.size() == 4u));
+
+    sub = ref.subspan(1u, 3u);
+    REQUIRE(sub.data() == array + 1);
+    REQUIRE((sub.size() == 3u));
+
+    REQUIRE((ref.subspan(5u).size() == 0u));
+}
+
+TEST_CASE("strided_array_ref")
+{
+    // 3x4 row-major matrix
+    int            matrix[12] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    array_ref<int> ref(matrix);
+
+    SECTION("every other element")
+    {
+        auto even = strided(ref, 2u);
+        REQUIRE((even.size() == 6u));
+        REQUIRE((even.stride() == 2u));
+        REQUIRE(even[0u] == 0);
+        REQUIRE(even[5u] == 10);
+
+        std::vector<int> elements(even.begin(), even.end());
+        REQUIRE(elements == (std::vector<int>{0, 2, 4, 6, 8, 10}));
+
+        auto every_fifth = strided(ref, 5u);
+        REQUIRE((every_fifth.size() == 3u));
+        REQUIRE(every_fifth[2u] == 10);
+    }
+    SECTION("column")
+    {
+        auto column = strided(ref.subspan(2u), 4u);
+        REQUIRE((column.size() == 3u));
+
+        std::vector<int> elements(column.begin(), column.end());
+        REQUIRE(elements == (std::vector<int>{2, 6, 10}));
+
+        column[1u] = 100;
+        REQUIRE(matrix[6] == 100);
+
+        // the last column, the stride goes past the end of the matrix
+        auto last = strided(ref.subspan(3u), 4u);
+        REQUIRE((last.size() == 3u));
+        REQUIRE(std::vector<int>(last.begin(), last.end()) == (std::vector<int>{3, 7, 11}));
+    }
+    SECTION("size not a multiple of the stride")
+    {
+        auto every_fourth = strided(array_ref<int>(matrix, 10u), 4u);
+        REQUIRE((every_fourth.size() == 3u));
+        REQUIRE(every_fourth[2u] == 8);
+
+        std::vector<int> elements;
+        for (auto iter = every_fourth.begin(); iter != every_fourth.end(); ++iter)
+            elements.push_back(*iter);
+        REQUIRE(elements == (std::vector<int>{0, 4, 8}));
+    }
+    SECTION("empty")
+    {
+        auto empty = strided(array_ref<int>(nullptr), 3u);
+        REQUIRE((empty.size() == 0u));
+        REQUIRE(empty.begin() == empty.end());
+    }
+}
+
+TEST_CASE("chunks")
+{
+    int            array[7] = {1, 2, 3, 4, 5, 6, 7};
+    array_ref<int> ref(array);
+
+    auto range = chunks(ref, 3u);
+    REQUIRE((range.size() == 3u));
+    REQUIRE(!range.empty());
+
+    REQUIRE(range[0u].data() == array);
+    REQUIRE((range[0u].size() == 3u));
+    REQUIRE(range[2u].data() == array + 6);
+    REQUIRE((range[2u].size() == 1u));
+
+    std::vector<std::size_t> sizes;
+    for (auto chunk : range)
+        sizes.push_back(static_cast<std::size_t>(chunk.size()));
+    REQUIRE(sizes == (std::vector<std::size_t>{3u, 3u, 1u}));
+
+    REQUIRE((chunks(ref, 7u).size() == 1u));
+    REQUIRE(chunks(array_ref<int>(nullptr), 2u).empty());
+    REQUIRE(chunks(array_ref<int>(nullptr), 2u).begin()
+            == chunks(array_ref<int>(nullptr), 2u).end());
+}
@@ -0,0 +1,128 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/bit_packed.hpp>
+
+#include <catch.hpp>
+
+using namespace type_safe;
+
+namespace
+{
+enum class packet_kind
+{
+    data,
+    ack,
+    reset,
+    _flag_set_size,
+};
+
+enum class packet_options
+{
+    urgent,
+    compressed,
+    encrypted,
+    _flag_set_size,
+};
+
+using version = bounded_type<int, true, true, std::integral_constant<int, 1>,
+                             std::integral_constant<int, 4>>;
+using ttl
+    = compact_bounded_type<unsigned, true, true, std::integral_constant<unsigned, 0u>,
+                           std::integral_constant<unsigned, 255u>>;
+using priority = bounded_type<int, true, false, std::integral_constant<int, -8>,
+                              std::integral_constant<int, 8>, throwing_verifier>;
+
+using header
+    = bit_packed<version, packet_kind, flag, flag_set<packet_options>, ttl, priority, flag>;
+} // namespace
+
+TEST_CASE("bit_packed")
+{
+    // 2 + 2 + 1 + 3 + 8 + 4 + 1
+    static_assert(header::bit_size == 21u, "");
+    static_assert(header::byte_size == 3u, "");
+    static_assert(sizeof(header) == 3u, "");
+    static_assert(std::is_same<header::field_type<4>, ttl>::value, "");
+
+    header h;
+    REQUIRE(h.get<version>().get_value() == 1);
+    REQUIRE(h.get<packet_kind>() == packet_kind::data);
+    REQUIRE(h.get<2>() == false);
+    REQUIRE(h.get<flag_set<packet_options>>() == noflag);
+    REQUIRE(h.get<ttl>().get_value() == 0u);
+    REQUIRE(h.get<priority>().get_value() == -8);
+    REQUIRE(h.get<6>() == false);
+
+    h.set(version(3));
+    h.set(packet_kind::reset);
+    h.set<2>(true);
+    h.set<flag_set<packet_options>>(packet_options::urgent | packet_options::encrypted);
+    h.set<ttl>(200u);
+    h.set<priority>(7);
+    h.set<6>(flag(true));
+
+    REQUIRE(h.get<version>().get_value() == 3);
+    REQUIRE(h.get<packet_kind>() == packet_kind::reset);
+    REQUIRE(h.get<2>() == true);
+    REQUIRE(h.get<flag_set<packet_options>>()
+            == (packet_options::urgent | packet_options::encrypted));
+    REQUIRE(h.get<ttl>().get_value() == 200u);
+    REQUIRE(h.get<priority>().get_value() == 7);
+    REQUIRE(h.get<6>() == true);
+
+    // fields don't overlap
+    h.set<ttl>(0u);
+    REQUIRE(h.get<flag_set<packet_options>>()
+            == (packet_options::urgent | packet_options::encrypted));
+    REQUIRE(h.get<priority>().get_value() == 7);
+
+    // verified through the field
+    REQUIRE_THROWS_AS(h.set<priority>(8), constrain_error);
+    REQUIRE(h.get<priority>().get_value() == 7);
+
+    SECTION("bit_packed_ref")
+    {
+        unsigned char buffer[4] = {0u, 0u, 0u, 0xFFu};
+
+        bit_packed_ref<version, packet_kind, flag, flag_set<packet_options>, ttl, priority, flag>
+            ref(buffer);
+        ref.set<ttl>(0xABu);
+        REQUIRE(ref.get<ttl>().get_value() == 0xABu);
+        // ttl starts at bit 8
+        REQUIRE(buffer[1] == 0xABu);
+        REQUIRE(buffer[3] == 0xFFu);
+
+        ref.set(version(4));
+        REQUIRE(buffer[0] == 0x03u);
+
+        bit_packed_cref<version, packet_kind, flag, flag_set<packet_options>, ttl, priority, flag>
+            cref(ref);
+        REQUIRE(cref.get<version>().get_value() == 4);
+        REQUIRE(cref.get<ttl>().get_value() == 0xABu);
+
+        bit_packed_cref<version, packet_kind, flag, flag_set<packet_options>, ttl, priority, flag>
+            record(h);
+        REQUIRE(record.get<version>().get_value() == 3);
+        REQUIRE(record.data() == h.data());
+    }
+    SECTION("padding")
+    {
+        // priority is -8 + 0xF = 7, bits 21 to 23 are not part of any field and ignored
+        const unsigned char buffer[3] = {0u, 0u, 0xFFu};
+        bit_packed_cref<version, packet_kind, flag, flag_set<packet_options>, ttl, priority, flag>
+            ref(buffer);
+        REQUIRE(ref.get<priority>().get_value() == 7);
+        REQUIRE(ref.get<6>() == true);
+    }
+    SECTION("corrupt buffer")
+    {
+        // packet_kind has three enumerators, but two bits can store 3
+        const unsigned char buffer[3] = {0x0Cu, 0u, 0u};
+        bit_packed_cref<version, packet_kind, flag, flag_set<packet_options>, ttl, priority, flag>
+            ref(buffer);
+        REQUIRE_THROWS_AS(ref.get<packet_kind>(), constrain_error);
+        REQUIRE(ref.get<version>().get_value() == 1);
+    }
+}
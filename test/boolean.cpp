@@ -75,4 +75,15 @@ TEST_CASE("boolean")
         in >> b;
         REQUIRE(!static_cast<bool>(b));
     }
+    SECTION("select")
+    {
+        REQUIRE(type_safe::select(true, 1, 2) == 1);
+        REQUIRE(type_safe::select(false, 1, 2) == 2);
+        REQUIRE(type_safe::select(boolean(true), -1, 2) == -1);
+        REQUIRE(type_safe::select(boolean(false), 1, -2) == -2);
+        REQUIRE(type_safe::select(true, 1u, 2u) == 1u);
+        REQUIRE(type_safe::select(false, 1u, 2u) == 2u);
+        REQUIRE(type_safe::select(true, 1.5, 2.5) == 1.5);
+        REQUIRE(type_safe::select(false, 1.5, 2.5) == 2.5);
+    }
 }
@@ -0,0 +1,168 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/boolean_vector.hpp>
+
+#include <catch.hpp>
+
+#include <vector>
+
+using namespace type_safe;
+
+namespace
+{
+enum class small_vector_flags
+{
+    a,
+    b,
+    c,
+    _flag_set_size,
+};
+
+enum class big_vector_flags
+{
+    a,
+    b              = 70,
+    c              = 99,
+    _flag_set_size = 100,
+};
+} // namespace
+
+TEST_CASE("boolean_vector")
+{
+    SECTION("constructor")
+    {
+        boolean_vector a;
+        REQUIRE(a.empty());
+        REQUIRE(a.size() == 0u);
+        REQUIRE(a.none());
+
+        boolean_vector b(100u);
+        REQUIRE(b.size() == 100u);
+        REQUIRE(b.none());
+        REQUIRE(b.count() == 0u);
+
+        boolean_vector c(100u, true);
+        REQUIRE(c.size() == 100u);
+        REQUIRE(c.all());
+        REQUIRE(c.count() == 100u);
+    }
+    SECTION("access")
+    {
+        boolean_vector vec(70u);
+        vec[3]  = true;
+        vec[64] = true;
+        REQUIRE(vec[3]);
+        REQUIRE(vec[64]);
+        REQUIRE(!vec[4]);
+        REQUIRE(vec.count() == 2u);
+
+        vec[4] = vec[3];
+        REQUIRE(vec[4]);
+        vec[3].flip();
+        REQUIRE(!vec[3]);
+        REQUIRE(!vec[64] == false);
+
+        const auto& cvec = vec;
+        REQUIRE(cvec[4]);
+        REQUIRE(!cvec[3]);
+    }
+    SECTION("push_back/pop_back/resize")
+    {
+        boolean_vector vec;
+        for (auto i = 0u; i != 130u; ++i)
+            vec.push_back(i % 3u == 0u);
+        REQUIRE(vec.size() == 130u);
+        REQUIRE(vec.count() == 44u);
+        REQUIRE(vec[129]);
+        REQUIRE(!vec[128]);
+
+        vec.pop_back();
+        REQUIRE(vec.size() == 129u);
+        REQUIRE(vec.count() == 43u);
+
+        vec.resize(200u, true);
+        REQUIRE(vec.size() == 200u);
+        REQUIRE(vec.count() == 43u + 71u);
+        REQUIRE(vec[199]);
+
+        vec.resize(10u);
+        REQUIRE(vec.count() == 4u);
+        vec.resize(64u);
+        REQUIRE(vec.count() == 4u);
+
+        vec.clear();
+        REQUIRE(vec.empty());
+    }
+    SECTION("find_first")
+    {
+        boolean_vector vec(200u);
+        REQUIRE(vec.find_first() == 200u);
+
+        vec[5]   = true;
+        vec[63]  = true;
+        vec[150] = true;
+        REQUIRE(vec.find_first() == 5u);
+        REQUIRE(vec.find_first(6u) == 63u);
+        REQUIRE(vec.find_first(64u) == 150u);
+        REQUIRE(vec.find_first(151u) == 200u);
+        REQUIRE(vec.find_first(300u) == 200u);
+
+        std::vector<std::size_t> indices;
+        vec.for_each_set([&](std::size_t i) { indices.push_back(i); });
+        REQUIRE(indices == (std::vector<std::size_t>{5u, 63u, 150u}));
+    }
+    SECTION("bulk operations")
+    {
+        boolean_vector a(100u), b(100u);
+        a[1]  = true;
+        a[2]  = true;
+        a[90] = true;
+        b[2]  = true;
+        b[91] = true;
+
+        auto c = a & b;
+        REQUIRE(c.count() == 1u);
+        REQUIRE(c[2]);
+
+        c = a | b;
+        REQUIRE(c.count() == 4u);
+
+        c = a ^ b;
+        REQUIRE(c.count() == 3u);
+        REQUIRE(!c[2]);
+
+        c = ~a;
+        REQUIRE(c.count() == 97u);
+        REQUIRE(c != a);
+        c.flip();
+        REQUIRE(c == a);
+
+        c = a;
+        REQUIRE(c.and_not(b).count() == 2u);
+        REQUIRE(c[1]);
+        REQUIRE(c[90]);
+        REQUIRE(c.and_not(a).none());
+    }
+    SECTION("flag_set")
+    {
+        flag_set<small_vector_flags> small(small_vector_flags::a | small_vector_flags::c);
+        boolean_vector               a(small);
+        REQUIRE(a.size() == 3u);
+        REQUIRE(a[0]);
+        REQUIRE(!a[1]);
+        REQUIRE(a[2]);
+        REQUIRE(a.to_flag_set<small_vector_flags>() == small);
+
+        flag_set<big_vector_flags> big(big_vector_flags::b | big_vector_flags::c);
+        boolean_vector             b(big);
+        REQUIRE(b.size() == 100u);
+        REQUIRE(b.count() == 2u);
+        REQUIRE(b[70]);
+        REQUIRE(b[99]);
+
+        b[0] = true;
+        REQUIRE(b.to_flag_set<big_vector_flags>() == (big | big_vector_flags::a));
+    }
+}
@@ -0,0 +1,93 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/bounded_array.hpp>
+
+#include <catch.hpp>
+
+#include <string>
+
+using namespace type_safe;
+
+TEST_CASE("bounded_array")
+{
+    using array     = bounded_array<int, true, true>;
+    using predicate = array::constraint_predicate;
+
+    SECTION("constructor")
+    {
+        array a(predicate(0, 10));
+        REQUIRE(a.empty());
+        REQUIRE(a.get_constraint().get_lower_bound() == 0);
+        REQUIRE(a.get_constraint().get_upper_bound() == 10);
+
+        array b(3u, 5, predicate(0, 10));
+        REQUIRE(static_cast<std::size_t>(b.size()) == 3u);
+        REQUIRE(std::vector<int>(b.begin(), b.end()) == (std::vector<int>{5, 5, 5}));
+
+        array c(std::vector<int>{1, 2, 3}, predicate(0, 10));
+        REQUIRE(std::vector<int>(c.begin(), c.end()) == (std::vector<int>{1, 2, 3}));
+
+        array d(assume_valid, std::vector<int>{4, 5}, predicate(0, 10));
+        REQUIRE(std::vector<int>(d.begin(), d.end()) == (std::vector<int>{4, 5}));
+
+        using throwing_array = bounded_array<int, true, true, constraints::dynamic_bound,
+                                             constraints::dynamic_bound, throwing_verifier>;
+        REQUIRE_THROWS_AS(throwing_array(std::vector<int>{1, 11}, predicate(0, 10)),
+                          constrain_error);
+
+        using clamping_array = bounded_array<int, true, true, constraints::dynamic_bound,
+                                             constraints::dynamic_bound, clamping_verifier>;
+        clamping_array e(std::vector<int>{-1, 5, 11}, predicate(0, 10));
+        REQUIRE(std::vector<int>(e.begin(), e.end()) == (std::vector<int>{0, 5, 10}));
+
+        // elements must not be moved from while verifying them
+        using string_array = bounded_array<std::string, true, true, constraints::dynamic_bound,
+                                           constraints::dynamic_bound, null_verifier>;
+        string_array f(std::vector<std::string>{"a string that doesn't fit into the small buffer"},
+                       string_array::constraint_predicate("a", "z"));
+        REQUIRE(*f.begin() == "a string that doesn't fit into the small buffer");
+    }
+    SECTION("access")
+    {
+        array a(std::vector<int>{1, 2, 3}, predicate(0, 10));
+
+        const array& ca    = a;
+        auto         value = ca[1u];
+        static_assert(std::is_same<decltype(value), bounded_type<int, true, true>>::value, "");
+        REQUIRE(value.get_value() == 2);
+        REQUIRE(value.get_constraint().get_upper_bound() == 10);
+
+        auto ref = a[2u];
+        REQUIRE(ref.get_value() == 3);
+        *ref.modify() = 7;
+        REQUIRE(a.data()[2] == 7);
+
+        auto verified = a.get_verified();
+        REQUIRE(verified.data() == a.data());
+        REQUIRE(verified.get_constraint().get_upper_bound() == 10);
+    }
+    SECTION("modifiers")
+    {
+        using throwing_array = bounded_array<int, true, true, constraints::dynamic_bound,
+                                             constraints::dynamic_bound, throwing_verifier>;
+        throwing_array a(predicate(0, 10));
+        a.push_back(3);
+        a.push_back(10);
+        REQUIRE_THROWS_AS(a.push_back(11), constrain_error);
+        REQUIRE(static_cast<std::size_t>(a.size()) == 2u);
+
+        a.pop_back();
+        REQUIRE(static_cast<std::size_t>(a.size()) == 1u);
+        REQUIRE(std::move(a).release() == (std::vector<int>{3}));
+    }
+    SECTION("static bounds")
+    {
+        bounded_array<int, true, true, std::integral_constant<int, 0>,
+                      std::integral_constant<int, 10>>
+            a;
+        a.push_back(4);
+        REQUIRE(a[0u].get_value() == 4);
+    }
+}
@@ -227,6 +227,32 @@ TEST_CASE("bounded_type")
     REQUIRE(mixed_open.get_constraint().get_upper_bound() == 42);
 }
 
+TEST_CASE("bounded_type conversion")
+{
+    using percent = bounded_type<int, true, true, std::integral_constant<int, 0>,
+                                 std::integral_constant<int, 100>>;
+    using digit   = bounded_type<int, true, true, std::integral_constant<int, 0>,
+                               std::integral_constant<int, 9>>;
+    using positive_digit = bounded_type<int, false, true, std::integral_constant<int, 0>,
+                                        std::integral_constant<int, 9>>;
+    using dynamic        = bounded_type<int, true, true>;
+
+    static_assert(std::is_convertible<digit, percent>::value, "");
+    static_assert(std::is_convertible<positive_digit, digit>::value, "");
+    static_assert(std::is_convertible<positive_digit, percent>::value, "");
+    static_assert(!std::is_convertible<percent, digit>::value, "");
+    static_assert(!std::is_convertible<digit, positive_digit>::value, "");
+    static_assert(!std::is_convertible<digit, dynamic>::value, "");
+    static_assert(!std::is_convertible<dynamic, digit>::value, "");
+
+    digit   d(7);
+    percent p = d;
+    REQUIRE(p.get_value() == 7);
+
+    percent assumed(assume_valid, 42);
+    REQUIRE(assumed.get_value() == 42);
+}
+
 TEST_CASE("clamping_verifier")
 {
     SECTION("less_equal")
@@ -343,4 +369,62 @@ TEST_CASE("clamped_type")
 
     REQUIRE(mixed.get_constraint().get_lower_bound() == 0);
     REQUIRE(mixed.get_constraint().get_upper_bound() == 42);
+
+    // checked, but never clamped
+    clamped_type<int, std::integral_constant<int, 0>, std::integral_constant<int, 42>> assumed(
+        assume_valid, 42);
+    REQUIRE(assumed.get_value() == 42);
+}
+
+TEST_CASE("compact_bounded_type")
+{
+    using percent = compact_bounded_type<int, true, true, std::integral_constant<int, 0>,
+                                         std::integral_constant<int, 100>>;
+    static_assert(sizeof(percent) == 1u, "");
+
+    using port = compact_bounded_type<unsigned, false, true, std::integral_constant<unsigned, 0u>,
+                                      std::integral_constant<unsigned, 65535u>>;
+    static_assert(sizeof(port) == 2u, "");
+
+    using offset
+        = compact_bounded_type<long long, true, false, lit_detail::integer_bound<long long, -1000>,
+                               lit_detail::integer_bound<long long, -744>>;
+    static_assert(sizeof(offset) == 1u, "");
+
+    percent a(42);
+    REQUIRE(a.get_value() == 42);
+    REQUIRE(*a == 42);
+    REQUIRE(a.get_offset() == 42u);
+
+    a = 100;
+    REQUIRE(a.get_value() == 100);
+    REQUIRE(a.get_constraint()(100));
+    REQUIRE(!a.get_constraint()(101));
+
+    port p(1u);
+    REQUIRE(p.get_value() == 1u);
+    REQUIRE(p.get_offset() == 0u);
+
+    offset o(-1000);
+    REQUIRE(o.get_value() == -1000);
+    o = -745;
+    REQUIRE(o.get_value() == -745);
+    REQUIRE(o.get_offset() == 255u);
+
+    bounded_type<int, true, true, std::integral_constant<int, 0>, std::integral_constant<int, 100>>
+        uncompressed = a;
+    REQUIRE(uncompressed.get_value() == 100);
+    percent b(uncompressed);
+    REQUIRE(a == b);
+
+    b = 7;
+    REQUIRE(b < a);
+    REQUIRE(b != a);
+    REQUIRE(a >= b);
+
+    using clamped = compact_bounded_type<int, true, true, std::integral_constant<int, 10>,
+                                         std::integral_constant<int, 20>, clamping_verifier>;
+    REQUIRE(clamped(5).get_value() == 10);
+    REQUIRE(clamped(25).get_value() == 20);
+    REQUIRE(clamped(15).get_value() == 15);
 }
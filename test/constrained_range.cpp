@@ -0,0 +1,80 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/constrained_range.hpp>
+
+#include <catch.hpp>
+
+#include <vector>
+
+using namespace type_safe;
+
+TEST_CASE("constrained_range")
+{
+    std::vector<int> values;
+    for (auto i = 0; i != 200; ++i)
+        values.push_back(i % 50);
+    array_ref<int> range(values.data(), values.size());
+
+    constraints::closed_interval<int> interval(0, 49);
+
+    SECTION("find_invalid")
+    {
+        REQUIRE(find_invalid(range, interval) == index_t(200u));
+
+        values[150] = 50;
+        values[170] = -1;
+        REQUIRE(find_invalid(range, interval) == index_t(150u));
+
+        values[3] = 100;
+        REQUIRE(find_invalid(range, interval) == index_t(3u));
+
+        REQUIRE(find_invalid(array_ref<int>(nullptr), interval) == index_t(0u));
+    }
+    SECTION("verify_range")
+    {
+        auto result = verify_range(range, interval);
+        REQUIRE(result.has_value());
+        REQUIRE(static_cast<std::size_t>(result.value().size()) == 200u);
+        REQUIRE(result.value().data() == values.data());
+        REQUIRE(result.value()[index_t(51u)] == 1);
+        REQUIRE(result.value().get_constraint().get_upper_bound() == 49);
+
+        values[199] = 50;
+        REQUIRE(!verify_range(range, interval).has_value());
+    }
+    SECTION("sanitize_range")
+    {
+        auto result = sanitize_range(cref(values.data(), values.data() + values.size()), interval);
+        REQUIRE(static_cast<std::size_t>(result.size()) == 200u);
+
+        values[42] = 50;
+        REQUIRE_THROWS_AS(sanitize_range(range, interval), constrain_error);
+    }
+    SECTION("clamp_range")
+    {
+        auto result = clamp_range(range, constraints::closed_interval<int>(10, 20));
+        REQUIRE(static_cast<std::size_t>(result.size()) == 200u);
+        for (auto value : result)
+        {
+            REQUIRE(value >= 10);
+            REQUIRE(value <= 20);
+        }
+        REQUIRE(values[0] == 10);
+        REQUIRE(values[15] == 15);
+        REQUIRE(values[49] == 20);
+
+        clamp_range(range, constraints::less_equal<int>(12));
+        REQUIRE(values[49] == 12);
+        clamp_range(range, constraints::greater_equal<int>(11));
+        REQUIRE(values[0] == 11);
+    }
+    SECTION("non_null")
+    {
+        int  a = 0, b = 1;
+        int* pointers[] = {&a, &b, nullptr};
+        REQUIRE(find_invalid(array_ref<int*>(pointers), constraints::non_null{}) == index_t(2u));
+        REQUIRE(verify_range(array_ref<int*>(pointers, 2u), constraints::non_null{}).has_value());
+    }
+}
@@ -46,6 +46,18 @@ TEST_CASE("constrained_type")
         my_int c(-1);
         REQUIRE(c.get_value() == -1);
     }
+    SECTION("assume_valid")
+    {
+        // only checked by the predicate, the verifier isn't called
+        test_verifier::expected = false;
+        my_int a(assume_valid, 5);
+        auto   value = -4;
+        my_int b(assume_valid, value);
+
+        test_verifier::expected = true;
+        REQUIRE(a.get_value() == 5);
+        REQUIRE(b.get_value() == -4);
+    }
     SECTION("assignment")
     {
         test_verifier::expected = true;
@@ -105,6 +117,49 @@ TEST_CASE("constrained_type")
     }
 }
 
+TEST_CASE("constrained_type verification count")
+{
+    struct counting_predicate
+    {
+        int* count;
+
+        bool operator()(int i) const
+        {
+            ++*count;
+            return i != -1;
+        }
+    };
+    using my_int = constrained_type<int, counting_predicate>;
+
+    auto   count = 0;
+    my_int a(1, counting_predicate{&count});
+    my_int b(2, counting_predicate{&count});
+    REQUIRE(count == 2);
+
+    // copy constructor verifies the source
+    count = 0;
+    my_int c(a);
+    REQUIRE(count <= 1);
+    REQUIRE(c.get_value() == 1);
+
+    // copy assignment verifies only the source
+    count = 0;
+    c     = b;
+    REQUIRE(count <= 1);
+
+    // value assignment verifies only the new value
+    count = 0;
+    c     = 3;
+    REQUIRE(count == 1);
+
+    // swap doesn't verify
+    count = 0;
+    swap(a, b);
+    REQUIRE(count == 0);
+    REQUIRE(a.get_value() == 2);
+    REQUIRE(b.get_value() == 1);
+}
+
 TEST_CASE("constrained_ref")
 {
     using my_ref = constrained_ref<int, test_predicate, test_verifier>;
@@ -125,6 +180,12 @@ TEST_CASE("constrained_ref")
         my_ref c(invalid);
         REQUIRE(c.get_value() == -1);
     }
+    SECTION("assume_valid")
+    {
+        test_verifier::expected = true;
+        my_ref a(assume_valid, valid1);
+        REQUIRE(&a.get_value() == &valid1);
+    }
     SECTION("modify()")
     {
         // with() is the same
@@ -2,6 +2,7 @@
 // This file is subject to the license terms in the LICENSE file
 // found in the top-level directory of this distribution.
 
+#include <type_safe/atomic_flag.hpp>
 #include <type_safe/flag.hpp>
 
 #include <catch.hpp>
@@ -79,3 +80,75 @@ TEST_CASE("flag")
         REQUIRE(b == false);
     }
 }
+
+TEST_CASE("atomic_flag")
+{
+    SECTION("constructor")
+    {
+        atomic_flag a(true);
+        REQUIRE(a.load());
+
+        atomic_flag b(false);
+        REQUIRE(!b.load());
+    }
+    SECTION("toggle")
+    {
+        atomic_flag a(true);
+        REQUIRE(a.toggle());
+        REQUIRE(!a.load());
+
+        atomic_flag b(false);
+        REQUIRE(!b.toggle(std::memory_order_relaxed));
+        REQUIRE(b.load(std::memory_order_relaxed));
+    }
+    SECTION("change")
+    {
+        atomic_flag a(true);
+        a.change(false);
+        REQUIRE(!a.load());
+
+        atomic_flag b(false);
+        b.change(true);
+        REQUIRE(b.load());
+    }
+    SECTION("set")
+    {
+        atomic_flag a(true);
+        REQUIRE(a.set());
+        REQUIRE(a.load());
+
+        atomic_flag b(false);
+        REQUIRE(!b.set(std::memory_order_release));
+        REQUIRE(b.load(std::memory_order_acquire));
+    }
+    SECTION("try_set")
+    {
+        atomic_flag a(true);
+        REQUIRE(!a.try_set());
+        REQUIRE(a.load());
+
+        atomic_flag b(false);
+        REQUIRE(b.try_set(std::memory_order_acq_rel));
+        REQUIRE(b.load());
+    }
+    SECTION("reset")
+    {
+        atomic_flag a(true);
+        REQUIRE(a.reset());
+        REQUIRE(!a.load());
+
+        atomic_flag b(false);
+        REQUIRE(!b.reset(std::memory_order_relaxed));
+        REQUIRE(!b.load());
+    }
+    SECTION("try_reset")
+    {
+        atomic_flag a(true);
+        REQUIRE(a.try_reset());
+        REQUIRE(!a.load());
+
+        atomic_flag b(false);
+        REQUIRE(!b.try_reset(std::memory_order_acq_rel));
+        REQUIRE(!b.load());
+    }
+}
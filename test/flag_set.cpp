@@ -2,10 +2,15 @@
 // This file is subject to the license terms in the LICENSE file
 // found in the top-level directory of this distribution.
 
+#include <type_safe/atomic_flag.hpp>
 #include <type_safe/flag_set.hpp>
 
 #include <catch.hpp>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 // no using namespace to test operator namespace
 
 enum class test_flags
@@ -202,6 +207,15 @@ TEST_CASE("flag_set")
 
         s.toggle_all();
         check_set(s, true, true, false);
+
+        s.set_all(true);
+        check_set(s, true, true, true);
+
+        s.set_all(false);
+        check_set(s, false, false, false);
+
+        s.set_all(flag(true));
+        check_set(s, true, true, true);
     }
     SECTION("binary op")
     {
@@ -220,4 +234,251 @@ TEST_CASE("flag_set")
         s ^= test_flags::a | test_flags::c;
         check_set(s, true, false, false);
     }
+    SECTION("count/iteration")
+    {
+        auto get_flags = [](const set& flags) {
+            std::vector<test_flags> result;
+            for (auto f : flags)
+                result.push_back(f);
+
+            std::vector<test_flags> result_for_each;
+            flags.for_each_set([&](test_flags f) { result_for_each.push_back(f); });
+            REQUIRE(result == result_for_each);
+            REQUIRE(result.size() == flags.count());
+
+            return result;
+        };
+
+        REQUIRE(s.count() == 0u);
+        REQUIRE(s.begin() == s.end());
+        REQUIRE(get_flags(s).empty());
+
+        s.set(test_flags::b);
+        REQUIRE(s.count() == 1u);
+        REQUIRE(*s.begin() == test_flags::b);
+        REQUIRE(get_flags(s) == std::vector<test_flags>{test_flags::b});
+
+        s |= test_flags::a | test_flags::c;
+        REQUIRE(s.count() == 3u);
+        REQUIRE(get_flags(s)
+                == (std::vector<test_flags>{test_flags::a, test_flags::b, test_flags::c}));
+
+        s.reset(test_flags::b);
+        REQUIRE(s.count() == 2u);
+        REQUIRE(get_flags(s) == (std::vector<test_flags>{test_flags::a, test_flags::c}));
+    }
+}
+
+enum class big_test_flags
+{
+    a,
+    b              = 63,
+    c              = 64,
+    d              = 129,
+    e              = 149,
+    _flag_set_size = 150,
+};
+
+TEST_CASE("flag_set multiple words")
+{
+    using namespace type_safe;
+
+    using set = flag_set<big_test_flags>;
+
+    set s;
+    REQUIRE(s.none());
+    REQUIRE(s == noflag);
+
+    s.set(big_test_flags::b);
+    s.set(big_test_flags::c);
+    REQUIRE(s.any());
+    REQUIRE(s.is_set(big_test_flags::b));
+    REQUIRE(s.is_set(big_test_flags::c));
+    REQUIRE(!s.is_set(big_test_flags::a));
+    REQUIRE(!s.is_set(big_test_flags::d));
+    REQUIRE(s == (big_test_flags::b | big_test_flags::c));
+    REQUIRE((s & big_test_flags::c));
+    REQUIRE(!(s & (big_test_flags::a | big_test_flags::e)));
+
+    s.reset(big_test_flags::b);
+    REQUIRE(s == big_test_flags::c);
+
+    s.toggle(big_test_flags::e);
+    REQUIRE(s == (big_test_flags::c | big_test_flags::e));
+
+    s.set(big_test_flags::d, false);
+    REQUIRE(s == (big_test_flags::c | big_test_flags::e));
+
+    s.set_all();
+    REQUIRE(s.all());
+    REQUIRE(s == (combo(~big_test_flags::a & ~big_test_flags::b) | big_test_flags::a
+                  | big_test_flags::b));
+
+    s &= ~big_test_flags::d;
+    REQUIRE(!s.all());
+    REQUIRE(!s.is_set(big_test_flags::d));
+    REQUIRE(s.is_set(big_test_flags::e));
+
+    s = ~s;
+    REQUIRE(s == big_test_flags::d);
+
+    s ^= big_test_flags::d | big_test_flags::a;
+    REQUIRE(s == big_test_flags::a);
+
+    s.toggle_all();
+    REQUIRE(s == combo(~big_test_flags::a));
+    REQUIRE(s.count() == 149u);
+    s.reset_all();
+    REQUIRE(s.none());
+    REQUIRE(s.count() == 0u);
+    REQUIRE(s.begin() == s.end());
+
+    s = big_test_flags::a | big_test_flags::b | big_test_flags::c | big_test_flags::d
+        | big_test_flags::e;
+    REQUIRE(s.count() == 5u);
+
+    std::vector<big_test_flags> flags;
+    for (auto f : s)
+        flags.push_back(f);
+    REQUIRE(flags
+            == (std::vector<big_test_flags>{big_test_flags::a, big_test_flags::b,
+                                            big_test_flags::c, big_test_flags::d,
+                                            big_test_flags::e}));
+
+    std::vector<big_test_flags> flags_for_each;
+    s.for_each_set([&](big_test_flags f) { flags_for_each.push_back(f); });
+    REQUIRE(flags == flags_for_each);
+}
+
+TEST_CASE("atomic_flag_set")
+{
+    using namespace type_safe;
+
+    using set = atomic_flag_set<test_flags>;
+
+    set s;
+    check_set(s.load(), false, false, false);
+
+    SECTION("constructor/store/exchange")
+    {
+        set a(test_flags::a | test_flags::c);
+        check_set(a.load(), true, false, true);
+
+        a.store(test_flags::b, std::memory_order_release);
+        check_set(a.load(std::memory_order_acquire), false, true, false);
+
+        check_set(a.exchange(noflag), false, true, false);
+        check_set(a.load(), false, false, false);
+    }
+    SECTION("set/reset/toggle")
+    {
+        REQUIRE(!s.set(test_flags::a));
+        REQUIRE(s.set(test_flags::a, std::memory_order_relaxed));
+        check_set(s.load(), true, false, false);
+        REQUIRE(s.is_set(test_flags::a));
+        REQUIRE(!s.is_set(test_flags::b));
+
+        REQUIRE(s.try_set(test_flags::b));
+        REQUIRE(!s.try_set(test_flags::b));
+        check_set(s.load(), true, true, false);
+
+        REQUIRE(s.reset(test_flags::a));
+        REQUIRE(!s.reset(test_flags::a));
+        check_set(s.load(), false, true, false);
+
+        REQUIRE(s.try_reset(test_flags::b));
+        REQUIRE(!s.try_reset(test_flags::b));
+        check_set(s.load(), false, false, false);
+
+        REQUIRE(!s.toggle(test_flags::c));
+        check_set(s.load(), false, false, true);
+        REQUIRE(s.toggle(test_flags::c, std::memory_order_acq_rel));
+        check_set(s.load(), false, false, false);
+    }
+    SECTION("binary op")
+    {
+        check_set(s.fetch_or(test_flags::a), false, false, false);
+        check_set(s.fetch_or(test_flags::b | test_flags::c), true, false, false);
+        check_set(s.fetch_and(~test_flags::c), true, true, true);
+        check_set(s.fetch_xor(test_flags::a | test_flags::c), true, true, false);
+        check_set(s.load(), false, true, true);
+    }
+    SECTION("transition")
+    {
+        REQUIRE(s.transition(noflag, test_flags::a));
+        check_set(s.load(), true, false, false);
+
+        REQUIRE(!s.transition(noflag, test_flags::b));
+        check_set(s.load(), true, false, false);
+
+        REQUIRE(s.transition(test_flags::a, test_flags::b | test_flags::c,
+                             std::memory_order_acq_rel, std::memory_order_acquire));
+        check_set(s.load(), false, true, true);
+
+        REQUIRE(!s.transition(test_flags::b, test_flags::a, std::memory_order_relaxed));
+        check_set(s.load(), false, true, true);
+    }
+    SECTION("concurrent")
+    {
+        constexpr auto thread_count = 8u;
+        for (auto round = 0u; round != 100u; ++round)
+        {
+            atomic_flag flag(false);
+            set         state(test_flags::a);
+
+            std::atomic<bool>     start(false);
+            std::atomic<unsigned> flag_winners(0u), set_winners(0u), transition_winners(0u);
+
+            std::vector<std::thread> threads;
+            for (auto i = 0u; i != thread_count; ++i)
+                threads.emplace_back([&] {
+                    while (!start.load())
+                        std::this_thread::yield();
+
+                    if (flag.try_set())
+                        ++flag_winners;
+                    if (s.try_set(test_flags::c))
+                        ++set_winners;
+                    if (state.transition(test_flags::a, test_flags::b))
+                        ++transition_winners;
+                });
+            start = true;
+            for (auto& thread : threads)
+                thread.join();
+
+            REQUIRE(flag_winners == 1u);
+            REQUIRE(set_winners == 1u);
+            REQUIRE(transition_winners == 1u);
+            REQUIRE(flag.load());
+            check_set(state.load(), false, true, false);
+
+            s.reset(test_flags::c);
+        }
+    }
+}
+
+TEST_CASE("flag_set iteration full integer")
+{
+    using namespace type_safe;
+
+    enum class full_flags
+    {
+        first,
+        last           = 63,
+        _flag_set_size = 64,
+    };
+
+    flag_set<full_flags> s(full_flags::first | full_flags::last);
+    REQUIRE(s.count() == 2u);
+
+    auto iter = s.begin();
+    REQUIRE(*iter == full_flags::first);
+    ++iter;
+    REQUIRE(*iter == full_flags::last);
+    ++iter;
+    REQUIRE(iter == s.end());
+
+    s.set_all();
+    REQUIRE(s.count() == 64u);
+    REQUIRE(s.all());
 }
@@ -0,0 +1,65 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/flag_set_column.hpp>
+
+#include <catch.hpp>
+
+#include <vector>
+
+using namespace type_safe;
+
+namespace
+{
+enum class column_flags
+{
+    a,
+    b,
+    c,
+    _flag_set_size,
+};
+} // namespace
+
+TEST_CASE("flag_set_column")
+{
+    using set = flag_set<column_flags>;
+
+    std::vector<set> rows;
+    for (auto i = 0u; i != 200u; ++i)
+    {
+        set s;
+        s.set(column_flags::a, i % 2u == 0u);
+        s.set(column_flags::b, i % 3u == 0u);
+        s.set(column_flags::c, i % 5u == 0u);
+        rows.push_back(s);
+    }
+
+    flag_set_column<column_flags> column(cref(rows.data(), rows.size()));
+    REQUIRE(column.size() == 200u);
+    for (auto i = 0u; i != 200u; ++i)
+        REQUIRE(column[i] == rows[i]);
+
+    auto check = [&](const boolean_vector& bitmap, bool (*predicate)(const set&)) {
+        REQUIRE(bitmap.size() == rows.size());
+        for (auto i = 0u; i != 200u; ++i)
+            REQUIRE(bitmap[i] == predicate(rows[i]));
+    };
+
+    check(column.column(column_flags::b), [](const set& s) { return s.is_set(column_flags::b); });
+    check(column.matching(column_flags::a | column_flags::b, ~column_flags::c),
+          [](const set& s) {
+              return s.is_set(column_flags::a) && s.is_set(column_flags::b)
+                     && !s.is_set(column_flags::c);
+          });
+    check(column.matching(column_flags::c), [](const set& s) { return s.is_set(column_flags::c); });
+    check(column.matching(noflag, ~column_flags::a & ~column_flags::b),
+          [](const set& s) { return !s.is_set(column_flags::a) && !s.is_set(column_flags::b); });
+    check(column.matching_any(column_flags::b | column_flags::c),
+          [](const set& s) { return s.is_set(column_flags::b) || s.is_set(column_flags::c); });
+
+    column.push_back(column_flags::a | column_flags::b);
+    REQUIRE(column.size() == 201u);
+    REQUIRE(column[200u] == (column_flags::a | column_flags::b));
+    REQUIRE(column.matching(column_flags::a | column_flags::b, ~column_flags::c)[200u]);
+}
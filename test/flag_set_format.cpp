@@ -0,0 +1,146 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/flag_set_format.hpp>
+
+#include <catch.hpp>
+
+#include <cstring>
+#include <string>
+
+using namespace type_safe;
+
+namespace
+{
+enum class format_flags
+{
+    read,
+    write,
+    execute,
+    _flag_set_size,
+};
+
+enum class many_format_flags
+{
+    _flag_set_size = 100,
+};
+
+template <typename Enum>
+optional<flag_set<Enum>> parse(const char* str)
+{
+    return parse_flag_set<Enum>(str, std::strlen(str));
+}
+} // namespace
+
+namespace type_safe
+{
+template <>
+struct flag_set_names<format_flags> : std::true_type
+{
+    static constexpr const char* name(std::size_t i) noexcept
+    {
+        constexpr const char* names[] = {"read", "write", "execute"};
+        return names[i];
+    }
+};
+
+template <>
+struct flag_set_names<many_format_flags> : std::true_type
+{
+    static constexpr const char* name(std::size_t i) noexcept
+    {
+        // "f0" to "f99"
+        constexpr const char* names[] = {
+            "f0",  "f1",  "f2",  "f3",  "f4",  "f5",  "f6",  "f7",  "f8",  "f9",  "f10", "f11",
+            "f12", "f13", "f14", "f15", "f16", "f17", "f18", "f19", "f20", "f21", "f22", "f23",
+            "f24", "f25", "f26", "f27", "f28", "f29", "f30", "f31", "f32", "f33", "f34", "f35",
+            "f36", "f37", "f38", "f39", "f40", "f41", "f42", "f43", "f44", "f45", "f46", "f47",
+            "f48", "f49", "f50", "f51", "f52", "f53", "f54", "f55", "f56", "f57", "f58", "f59",
+            "f60", "f61", "f62", "f63", "f64", "f65", "f66", "f67", "f68", "f69", "f70", "f71",
+            "f72", "f73", "f74", "f75", "f76", "f77", "f78", "f79", "f80", "f81", "f82", "f83",
+            "f84", "f85", "f86", "f87", "f88", "f89", "f90", "f91", "f92", "f93", "f94", "f95",
+            "f96", "f97", "f98", "f99"};
+        return names[i];
+    }
+};
+} // namespace type_safe
+
+TEST_CASE("flag_set_format")
+{
+    SECTION("flag_name")
+    {
+        static_assert(flag_name(format_flags::write)[0] == 'w', "");
+        REQUIRE(flag_name(format_flags::read) == std::string("read"));
+        REQUIRE(flag_name(format_flags::execute) == std::string("execute"));
+    }
+    SECTION("perfect hash")
+    {
+#if TYPE_SAFE_USE_CONSTEXPR14
+        constexpr auto table = detail::make_flag_name_table<many_format_flags>();
+        static_assert(table.valid, "");
+#endif
+        REQUIRE(detail::get_flag_name_table<many_format_flags>().valid);
+        for (auto i = 0u; i != 100u; ++i)
+        {
+            auto name = flag_name(static_cast<many_format_flags>(i));
+            auto flag = parse_flag<many_format_flags>(name, std::strlen(name));
+            REQUIRE(flag);
+            REQUIRE(static_cast<unsigned>(flag.value()) == i);
+        }
+        REQUIRE(!parse_flag<many_format_flags>("f100", 4u));
+        REQUIRE(!parse_flag<many_format_flags>("f", 1u));
+        REQUIRE(!parse_flag<many_format_flags>("", 0u));
+    }
+    SECTION("parse_flag")
+    {
+        REQUIRE(parse_flag<format_flags>("write", 5u).value() == format_flags::write);
+        // not null-terminated
+        REQUIRE(parse_flag<format_flags>("readwrite", 4u).value() == format_flags::read);
+        REQUIRE(!parse_flag<format_flags>("writ", 4u));
+        REQUIRE(!parse_flag<format_flags>("Write", 5u));
+        // embedded null character where the name ends
+        REQUIRE(!parse_flag<format_flags>("read\0ab", 7u));
+        REQUIRE(!parse_flag<many_format_flags>("f1\0", 3u));
+    }
+    SECTION("format_flag_set")
+    {
+        char buffer[32];
+
+        flag_set<format_flags> set;
+        REQUIRE(format_flag_set(set, buffer, sizeof(buffer)) == 0u);
+
+        set.set(format_flags::read);
+        set.set(format_flags::execute);
+        auto length = format_flag_set(set, buffer, sizeof(buffer));
+        REQUIRE(std::string(buffer, length) == "read|execute");
+
+        // truncated
+        REQUIRE(format_flag_set(set, buffer, 6u) == length);
+        REQUIRE(std::string(buffer, 6u) == "read|e");
+
+        set.set(format_flags::write);
+        length = format_flag_set(set, buffer, sizeof(buffer));
+        REQUIRE(std::string(buffer, length) == "read|write|execute");
+    }
+    SECTION("parse_flag_set")
+    {
+        REQUIRE(parse<format_flags>("").value() == noflag);
+        REQUIRE(parse<format_flags>("write").value() == format_flags::write);
+        REQUIRE(parse<format_flags>("execute|read").value()
+                == (format_flags::read | format_flags::execute));
+        REQUIRE(parse<format_flags>("read|read").value() == format_flags::read);
+
+        REQUIRE(!parse<format_flags>("read|"));
+        REQUIRE(!parse<format_flags>("|read"));
+        REQUIRE(!parse<format_flags>("read||write"));
+        REQUIRE(!parse<format_flags>("read|foo"));
+        REQUIRE(!parse_flag_set<format_flags>("read\0|write", 11u));
+
+        auto str = "f1|f50|f99";
+        auto set = parse<many_format_flags>(str);
+        REQUIRE(set);
+        REQUIRE(set.value().count() == 3u);
+        REQUIRE(set.value().is_set(static_cast<many_format_flags>(50)));
+    }
+}
@@ -0,0 +1,18 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+// a second translation unit including the header,
+// linking fails if it defines non-inline functions
+#include <type_safe/flag_set_format.hpp>
+
+#include <catch.hpp>
+
+using namespace type_safe;
+
+TEST_CASE("flag_set_format in multiple translation units")
+{
+    REQUIRE(detail::flag_name_length("read") == 4u);
+    REQUIRE(detail::flag_name_equal("read", "read", 4u));
+    REQUIRE(detail::flag_name_hash("read", 4u) == detail::flag_name_hash("read", 4u));
+}
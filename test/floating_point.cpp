@@ -206,4 +206,13 @@ TEST_CASE("floating_point")
         in >> f;
         REQUIRE(static_cast<double>(f) == 1.0);
     }
+    SECTION("select")
+    {
+        float_t a(0.5);
+        float_t b(-1.5);
+        REQUIRE(static_cast<double>(type_safe::select(true, a, b)) == 0.5);
+        REQUIRE(static_cast<double>(type_safe::select(false, a, b)) == -1.5);
+        REQUIRE(static_cast<double>(type_safe::select(boolean(true), b, a)) == -1.5);
+        REQUIRE(static_cast<double>(type_safe::select(boolean(false), b, a)) == 0.5);
+    }
 }
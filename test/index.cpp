@@ -6,6 +6,15 @@
 
 #include <catch.hpp>
 
+#include <vector>
+
+// must be classes, so they can be forward declared
+namespace type_safe
+{
+struct index_t;
+struct difference_t;
+} // namespace type_safe
+
 using namespace type_safe;
 
 TEST_CASE("index_t")
@@ -102,4 +111,123 @@ TEST_CASE("index_t")
         for (index_t i; i != 5u; ++i)
             REQUIRE(at(array, i) == std::size_t(get(i)));
     }
+    SECTION("indices")
+    {
+        std::size_t array[] = {0, 1, 2, 3, 4, 5};
+        REQUIRE(indices(array).size() == 6u);
+
+        std::size_t count = 0u;
+        for (auto i : indices(array))
+        {
+            static_assert(std::is_same<decltype(i), valid_index<std::size_t[6]>>::value, "");
+            REQUIRE(at(array, i) == count);
+            REQUIRE(i.get_index() == index_t(count));
+            ++count;
+        }
+        REQUIRE(count == 6u);
+
+        std::vector<int> vec{4, 5, 6};
+        const auto&      cvec = vec;
+        for (auto i : indices(vec))
+        {
+            at(vec, i) += 1;
+            REQUIRE(at(cvec, i) == at(vec, index_t(i)));
+        }
+        REQUIRE(vec == (std::vector<int>{5, 6, 7}));
+
+        for (auto i : indices(vec))
+        {
+            REQUIRE(i + difference_t(1) == index_t(i) + difference_t(1));
+            REQUIRE(difference_t(1) + i == next(i));
+            REQUIRE(next(i, difference_t(2)) - difference_t(2) == i);
+            REQUIRE(prev(i + difference_t(1)) == i);
+            REQUIRE(i - i == difference_t(0));
+            REQUIRE(distance(i, index_t(3u)) == index_t(3u) - i);
+
+            index_t j = i;
+            advance(j, difference_t(1));
+            REQUIRE(j == i + difference_t(1));
+        }
+
+        std::vector<int> empty;
+        REQUIRE(indices(empty).empty());
+        REQUIRE(indices(empty).begin() == indices(empty).end());
+    }
+}
+
+TEST_CASE("index32_t")
+{
+    static_assert(sizeof(index32_t) == sizeof(std::uint32_t), "");
+    static_assert(sizeof(difference32_t) == sizeof(std::int32_t), "");
+
+    index32_t idx;
+    REQUIRE(idx == index32_t(0u));
+
+    SECTION("arithmetic")
+    {
+        idx += difference32_t(5);
+        REQUIRE(idx == index32_t(5u));
+
+        idx -= difference32_t(3);
+        REQUIRE(idx == index32_t(2u));
+
+        ++idx;
+        REQUIRE(idx == index32_t(3u));
+
+        auto a = idx + difference32_t(2);
+        REQUIRE(a == index32_t(5u));
+        REQUIRE(difference32_t(2) + idx == a);
+        REQUIRE(a - difference32_t(4) == index32_t(1u));
+
+        REQUIRE(a - idx == difference32_t(2));
+        REQUIRE(idx - a == difference32_t(-2));
+        REQUIRE(distance(idx, a) == difference32_t(2));
+        REQUIRE(next(idx) == index32_t(4u));
+        REQUIRE(prev(idx, difference32_t(2)) == index32_t(1u));
+
+        advance(idx, difference32_t(-3));
+        REQUIRE(idx == index32_t(0u));
+    }
+    SECTION("above 2^31")
+    {
+        index32_t big(3000000000u);
+        ++big;
+        REQUIRE(big == index32_t(3000000001u));
+
+        big += difference32_t(1);
+        REQUIRE(big == index32_t(3000000002u));
+        big -= difference32_t(-2);
+        REQUIRE(big == index32_t(3000000004u));
+        big += difference32_t(-4);
+        REQUIRE(big == index32_t(3000000000u));
+
+        REQUIRE(index32_t(2000000000u) + difference32_t(2147483647) == index32_t(4147483647u));
+        REQUIRE(big - difference32_t(2147483647) - difference32_t(1) == index32_t(852516352u));
+
+        index32_t max(4294967295u);
+        REQUIRE(max - big == difference32_t(1294967295));
+        REQUIRE(index32_t(0u) - index32_t(2147483648u) == difference32_t(-2147483647 - 1));
+        REQUIRE(next(big) == index32_t(3000000001u));
+        REQUIRE(prev(max) == index32_t(4294967294u));
+    }
+    SECTION("conversion")
+    {
+        index32_t a(index_t(42u));
+        REQUIRE(a == index32_t(42u));
+
+        index_t b = a;
+        REQUIRE(b == index_t(42u));
+
+        difference32_t c(difference_t(-7));
+        REQUIRE(c == difference32_t(-7));
+
+        difference_t d = c;
+        REQUIRE(d == difference_t(-7));
+    }
+    SECTION("at")
+    {
+        std::vector<int> vec{0, 1, 2, 3};
+        for (index32_t i; i != index32_t(4u); ++i)
+            REQUIRE(at(vec, i) == static_cast<int>(static_cast<std::uint32_t>(get(i))));
+    }
 }
@@ -295,4 +295,13 @@ TEST_CASE("integer")
         ia = type_safe::abs(i);
         REQUIRE(static_cast<unsigned>(ia) == 123u);
     }
+    SECTION("select")
+    {
+        int_t a(-5);
+        int_t b(7);
+        REQUIRE(static_cast<int>(type_safe::select(true, a, b)) == -5);
+        REQUIRE(static_cast<int>(type_safe::select(false, a, b)) == 7);
+        REQUIRE(static_cast<int>(type_safe::select(boolean(true), b, a)) == 7);
+        REQUIRE(static_cast<int>(type_safe::select(boolean(false), b, a)) == -5);
+    }
 }
@@ -0,0 +1,149 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/multi_index.hpp>
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace type_safe;
+
+namespace
+{
+// checks that every index of a 2D layout is mapped to a different element
+template <class Layout>
+bool is_bijective(const Layout& layout)
+{
+    std::vector<bool> used(layout.size());
+    for (auto y = 0u; y != get(layout.extents()[0]); ++y)
+        for (auto x = 0u; x != get(layout.extents()[1]); ++x)
+        {
+            auto i = static_cast<std::size_t>(get(layout(multi_index<2>(y, x))));
+            if (i >= used.size() || used[i])
+                return false;
+            used[i] = true;
+        }
+    return true;
+}
+} // namespace
+
+TEST_CASE("multi_index")
+{
+    multi_index<3> a;
+    REQUIRE(a == multi_index<3>(0u, 0u, 0u));
+
+    multi_index<3> b(1u, 2u, 3u);
+    REQUIRE(b[0] == index_t(1u));
+    REQUIRE(b[1] == index_t(2u));
+    REQUIRE(b[2] == index_t(3u));
+    REQUIRE(a != b);
+
+    b[1] = index_t(5u);
+    REQUIRE(b == multi_index<3>(1u, 5u, 3u));
+
+    multi_difference<3> d(1, -1, 0);
+    REQUIRE(b + d == multi_index<3>(2u, 4u, 3u));
+    REQUIRE(d + b == multi_index<3>(2u, 4u, 3u));
+    REQUIRE(b - d == multi_index<3>(0u, 6u, 3u));
+    REQUIRE((b + d) - b == d);
+
+    b += d;
+    REQUIRE(b == multi_index<3>(2u, 4u, 3u));
+    b -= d;
+    REQUIRE(b == multi_index<3>(1u, 5u, 3u));
+}
+
+TEST_CASE("layout::row_major")
+{
+    layout::row_major<2> layout({3u, 4u});
+    REQUIRE(layout.size() == 12u);
+    REQUIRE(layout(multi_index<2>(0u, 0u)) == index_t(0u));
+    REQUIRE(layout(multi_index<2>(0u, 1u)) == index_t(1u));
+    REQUIRE(layout(multi_index<2>(2u, 3u)) == index_t(11u));
+    REQUIRE(is_bijective(layout));
+}
+
+TEST_CASE("layout::column_major")
+{
+    layout::column_major<2> layout({3u, 4u});
+    REQUIRE(layout.size() == 12u);
+    REQUIRE(layout(multi_index<2>(1u, 0u)) == index_t(1u));
+    REQUIRE(layout(multi_index<2>(0u, 1u)) == index_t(3u));
+    REQUIRE(layout(multi_index<2>(2u, 3u)) == index_t(11u));
+    REQUIRE(is_bijective(layout));
+}
+
+TEST_CASE("layout::strided")
+{
+    // every other column of a 3x8 matrix
+    layout::strided<2> layout({3u, 4u}, {{8u, 2u}});
+    REQUIRE(layout.size() == 23u);
+    REQUIRE(layout(multi_index<2>(1u, 1u)) == index_t(10u));
+    REQUIRE(is_bijective(layout));
+
+    layout::strided<2> empty({0u, 4u}, {{4u, 1u}});
+    REQUIRE(empty.size() == 0u);
+}
+
+TEST_CASE("layout::tiled")
+{
+    layout::tiled<2, 2> layout({3u, 5u});
+    REQUIRE(layout.size() == 4u * 6u);
+    // first tile
+    REQUIRE(layout(multi_index<2>(0u, 0u)) == index_t(0u));
+    REQUIRE(layout(multi_index<2>(0u, 1u)) == index_t(1u));
+    REQUIRE(layout(multi_index<2>(1u, 0u)) == index_t(2u));
+    REQUIRE(layout(multi_index<2>(1u, 1u)) == index_t(3u));
+    // second tile
+    REQUIRE(layout(multi_index<2>(0u, 2u)) == index_t(4u));
+    // first tile of the second row of tiles
+    REQUIRE(layout(multi_index<2>(2u, 0u)) == index_t(12u));
+    REQUIRE(is_bijective(layout));
+}
+
+TEST_CASE("layout::morton")
+{
+    layout::morton<2> layout({4u, 3u});
+    REQUIRE(layout.size() == 16u);
+    REQUIRE(layout(multi_index<2>(0u, 0u)) == index_t(0u));
+    REQUIRE(layout(multi_index<2>(0u, 1u)) == index_t(1u));
+    REQUIRE(layout(multi_index<2>(1u, 0u)) == index_t(2u));
+    REQUIRE(layout(multi_index<2>(1u, 1u)) == index_t(3u));
+    REQUIRE(layout(multi_index<2>(0u, 2u)) == index_t(4u));
+    REQUIRE(layout(multi_index<2>(3u, 2u)) == index_t(14u));
+    REQUIRE(is_bijective(layout));
+
+    layout::morton<3> cube({2u, 2u, 2u});
+    REQUIRE(cube.size() == 8u);
+    REQUIRE(cube(multi_index<3>(1u, 0u, 1u)) == index_t(5u));
+
+    layout::morton<2> single({1u, 1u});
+    REQUIRE(single.size() == 1u);
+    REQUIRE(single(multi_index<2>(0u, 0u)) == index_t(0u));
+}
+
+TEST_CASE("multi_array_ref")
+{
+    std::vector<int> vec(12u);
+
+    multi_array_ref<int, layout::row_major<2>> grid(array_ref<int>(vec.data(), vec.size()),
+                                                    layout::row_major<2>({3u, 4u}));
+    REQUIRE(grid.data() == vec.data());
+    REQUIRE(grid.extents() == multi_index<2>(3u, 4u));
+
+    grid[{1u, 2u}] = 42;
+    REQUIRE(vec[6] == 42);
+    REQUIRE(grid[multi_index<2>(1u, 2u) + multi_difference<2>(0, -1)] == 0);
+
+    multi_array_ref<int, layout::strided<2>> column(vec.data(),
+                                                    layout::strided<2>({3u, 1u}, {{4u, 1u}}));
+    column[{2u, 0u}] = 1;
+    REQUIRE(vec[8] == 1);
+
+    multi_array_ref<int, layout::morton<2>> morton(vec.data(), layout::morton<2>({2u, 2u}));
+    morton[{1u, 0u}] = 7;
+    REQUIRE(vec[2] == 7);
+}
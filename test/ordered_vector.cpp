@@ -0,0 +1,226 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/ordered_vector.hpp>
+
+#include <catch.hpp>
+
+using namespace type_safe;
+
+namespace
+{
+template <class Vector>
+std::vector<int> elements(const Vector& vec)
+{
+    return std::vector<int>(vec.begin(), vec.end());
+}
+
+bool greater_int(int a, int b)
+{
+    return a > b;
+}
+
+struct final_less final
+{
+    bool operator()(int a, int b) const
+    {
+        return a < b;
+    }
+};
+} // namespace
+
+TEST_CASE("constraints::sorted")
+{
+    constraints::sorted<int> p;
+    REQUIRE(p(std::vector<int>{}));
+    REQUIRE(p(std::vector<int>{1, 2, 2, 3}));
+    REQUIRE(!p(std::vector<int>{1, 3, 2}));
+
+    constraints::sorted<int, std::greater<int>> greater;
+    REQUIRE(greater(std::vector<int>{3, 2, 2, 1}));
+    REQUIRE(!greater(std::vector<int>{1, 2}));
+}
+
+TEST_CASE("constraints::sorted_unique")
+{
+    constraints::sorted_unique<int> p;
+    REQUIRE(p(std::vector<int>{}));
+    REQUIRE(p(std::vector<int>{1, 2, 3}));
+    REQUIRE(!p(std::vector<int>{1, 2, 2, 3}));
+    REQUIRE(!p(std::vector<int>{1, 3, 2}));
+}
+
+TEST_CASE("constraints::heap")
+{
+    constraints::heap<int> p;
+    REQUIRE(p(std::vector<int>{}));
+    REQUIRE(p(std::vector<int>{5, 3, 4, 1, 2}));
+    REQUIRE(!p(std::vector<int>{1, 2, 3}));
+}
+
+TEST_CASE("ordered constraints in constrained_type")
+{
+    constrained_type<std::vector<int>, constraints::sorted<int>> sorted(
+        std::vector<int>{1, 2, 2, 3});
+    REQUIRE(sorted.get_value().size() == 4u);
+
+    constrained_type<std::vector<int>, constraints::sorted_unique<int>> unique(
+        std::vector<int>{1, 2, 3});
+    REQUIRE(unique.get_value().size() == 3u);
+
+    constrained_type<std::vector<int>, constraints::heap<int>> heap(std::vector<int>{5, 3, 4});
+    REQUIRE(heap.get_value().front() == 5);
+}
+
+TEST_CASE("sorted_vector")
+{
+    sorted_vector<int> vec(std::vector<int>{4, 1, 3, 1});
+    REQUIRE(elements(vec) == (std::vector<int>{1, 1, 3, 4}));
+    REQUIRE(vec.get_constraint()(vec.get_vector()));
+
+    SECTION("lookup")
+    {
+        REQUIRE(vec.front() == 1);
+        REQUIRE(vec.back() == 4);
+        REQUIRE(vec.contains(3));
+        REQUIRE(!vec.contains(2));
+        REQUIRE(binary_search(vec, 4));
+        REQUIRE(vec.count(1) == 2u);
+        REQUIRE(vec.find(2) == vec.end());
+        REQUIRE(*vec.find(3) == 3);
+        REQUIRE(vec.lower_bound(3) - vec.begin() == 2);
+        REQUIRE(vec.upper_bound(1) - vec.begin() == 2);
+    }
+    SECTION("insert")
+    {
+        auto result = vec.insert(2);
+        REQUIRE(result.second);
+        REQUIRE(*result.first == 2);
+
+        result = vec.insert(1);
+        REQUIRE(result.second);
+        REQUIRE(result.first - vec.begin() == 2);
+        REQUIRE(elements(vec) == (std::vector<int>{1, 1, 1, 2, 3, 4}));
+
+        std::vector<int> more{5, 0, 3};
+        vec.insert(more.begin(), more.end());
+        REQUIRE(elements(vec) == (std::vector<int>{0, 1, 1, 1, 2, 3, 3, 4, 5}));
+    }
+    SECTION("erase")
+    {
+        REQUIRE(vec.erase(1) == 2u);
+        REQUIRE(elements(vec) == (std::vector<int>{3, 4}));
+
+        vec.erase(vec.begin());
+        REQUIRE(elements(vec) == (std::vector<int>{4}));
+
+        vec.clear();
+        REQUIRE(vec.empty());
+    }
+    SECTION("merge")
+    {
+        sorted_vector<int> other(std::vector<int>{0, 3, 5});
+
+        auto merged = merge(vec, other);
+        REQUIRE(elements(merged) == (std::vector<int>{0, 1, 1, 3, 3, 4, 5}));
+
+        vec.merge(other);
+        REQUIRE(elements(vec) == (std::vector<int>{0, 1, 1, 3, 3, 4, 5}));
+    }
+    SECTION("assume_valid")
+    {
+        sorted_vector<int> sorted(assume_valid, std::vector<int>{1, 2, 3});
+        REQUIRE(elements(sorted) == (std::vector<int>{1, 2, 3}));
+
+        auto released = std::move(sorted).release();
+        REQUIRE(released == (std::vector<int>{1, 2, 3}));
+    }
+    SECTION("compare")
+    {
+        sorted_vector<int, std::greater<int>> greater(std::vector<int>{1, 3, 2});
+        REQUIRE(elements(greater) == (std::vector<int>{3, 2, 1}));
+        REQUIRE(greater.contains(2));
+
+        sorted_vector<int, bool (*)(int, int)> function(std::vector<int>{1, 3, 2}, &greater_int);
+        REQUIRE(elements(function) == (std::vector<int>{3, 2, 1}));
+        function.insert(4);
+        REQUIRE(elements(function) == (std::vector<int>{4, 3, 2, 1}));
+
+        sorted_vector<int, final_less> final_vec(std::vector<int>{1, 3, 2});
+        REQUIRE(elements(final_vec) == (std::vector<int>{1, 2, 3}));
+    }
+}
+
+TEST_CASE("sorted_unique_vector")
+{
+    sorted_unique_vector<int> vec(std::vector<int>{4, 1, 3, 1});
+    REQUIRE(elements(vec) == (std::vector<int>{1, 3, 4}));
+    REQUIRE(vec.get_constraint()(vec.get_vector()));
+
+    SECTION("insert")
+    {
+        auto result = vec.insert(2);
+        REQUIRE(result.second);
+        REQUIRE(*result.first == 2);
+
+        result = vec.insert(3);
+        REQUIRE(!result.second);
+        REQUIRE(*result.first == 3);
+        REQUIRE(elements(vec) == (std::vector<int>{1, 2, 3, 4}));
+
+        std::vector<int> more{5, 1, 5};
+        vec.insert(more.begin(), more.end());
+        REQUIRE(elements(vec) == (std::vector<int>{1, 2, 3, 4, 5}));
+    }
+    SECTION("merge")
+    {
+        sorted_unique_vector<int> other(std::vector<int>{0, 3, 5});
+
+        auto merged = merge(vec, other);
+        REQUIRE(elements(merged) == (std::vector<int>{0, 1, 3, 4, 5}));
+
+        vec.merge(other);
+        REQUIRE(elements(vec) == (std::vector<int>{0, 1, 3, 4, 5}));
+    }
+}
+
+TEST_CASE("heap_vector")
+{
+    heap_vector<int> heap(std::vector<int>{3, 1, 4, 1, 5});
+    REQUIRE(heap.size() == 5u);
+    REQUIRE(heap.top() == 5);
+    REQUIRE(heap.get_constraint()(heap.get_vector()));
+
+    SECTION("push/pop")
+    {
+        heap.push(9);
+        heap.push(2);
+        REQUIRE(heap.top() == 9);
+
+        std::vector<int> popped;
+        while (!heap.empty())
+            popped.push_back(heap.pop());
+        REQUIRE(popped == (std::vector<int>{9, 5, 4, 3, 2, 1, 1}));
+    }
+    SECTION("sort")
+    {
+        auto sorted = std::move(heap).sort();
+        REQUIRE(elements(sorted) == (std::vector<int>{1, 1, 3, 4, 5}));
+    }
+    SECTION("assume_valid")
+    {
+        heap_vector<int> valid(assume_valid, std::vector<int>{5, 3, 4});
+        REQUIRE(valid.top() == 5);
+    }
+    SECTION("compare")
+    {
+        heap_vector<int, bool (*)(int, int)> function(std::vector<int>{3, 1, 4}, &greater_int);
+        REQUIRE(function.top() == 1);
+        function.push(0);
+        REQUIRE(function.pop() == 0);
+
+        heap_vector<int, final_less> final_heap(std::vector<int>{3, 1, 4});
+        REQUIRE(final_heap.top() == 4);
+    }
+}
@@ -0,0 +1,52 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/parallel.hpp>
+
+#include <catch.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace type_safe;
+
+TEST_CASE("parallel_for_each")
+{
+    std::vector<int> vec(10000u);
+    for (auto i = 0u; i != vec.size(); ++i)
+        vec[i] = static_cast<int>(i);
+    array_ref<int> ref(vec.data(), vec.size());
+
+    SECTION("all elements")
+    {
+        parallel_for_each(ref, [](int& i) { i *= 2; }, 64u, 4u);
+        for (auto i = 0u; i != vec.size(); ++i)
+            REQUIRE(vec[i] == static_cast<int>(2u * i));
+    }
+    SECTION("default arguments")
+    {
+        std::atomic<long long> sum(0);
+        parallel_for_each(ref, [&](int i) { sum += i; });
+        REQUIRE(sum == 9999ll * 10000ll / 2);
+    }
+    SECTION("single thread")
+    {
+        std::atomic<int> count(0);
+        parallel_for_each(ref, [&](int) { ++count; }, 1000u, 1u);
+        REQUIRE(count == 10000);
+    }
+    SECTION("empty")
+    {
+        parallel_for_each(array_ref<int>(nullptr), [](int) { FAIL("no elements"); });
+    }
+    SECTION("exception")
+    {
+        auto f = [](int i) {
+            if (i == 5000)
+                throw std::runtime_error("error");
+        };
+        REQUIRE_THROWS_AS(parallel_for_each(ref, f, 100u, 4u), std::runtime_error);
+    }
+}
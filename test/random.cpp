@@ -0,0 +1,126 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/random.hpp>
+
+#include <catch.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace type_safe;
+
+namespace
+{
+// returns the given values in order
+struct sequence_generator
+{
+    using result_type = std::uint_least32_t;
+
+    static constexpr result_type min()
+    {
+        return 0u;
+    }
+    static constexpr result_type max()
+    {
+        return 0xFFFFFFFFu;
+    }
+
+    result_type operator()()
+    {
+        REQUIRE(cur != values.size());
+        return values[cur++];
+    }
+
+    std::vector<result_type> values;
+    std::size_t              cur = 0u;
+};
+
+using die = bounded_type<int, true, true, std::integral_constant<int, 1>,
+                         std::integral_constant<int, 6>>;
+} // namespace
+
+TEST_CASE("bounded_random")
+{
+    SECTION("rejection")
+    {
+        // range 3 has threshold (2^32 - 3) % 3 = 1, so 0 is rejected
+        sequence_generator gen{{0u, 0xFFFFFFFFu, 0x80000000u}, 0u};
+        auto               random = make_bounded_random(gen);
+
+        using three
+            = bounded_type<unsigned, true, false, std::integral_constant<unsigned, 10u>,
+                           std::integral_constant<unsigned, 13u>>;
+        REQUIRE(random.generate<three>().get_value() == 12u);
+        REQUIRE(gen.cur == 2u);
+        REQUIRE(random.generate<three>().get_value() == 11u);
+    }
+    SECTION("static bounds")
+    {
+        std::mt19937 gen(42u);
+        auto         random = make_bounded_random(gen);
+
+        int counts[6] = {};
+        for (auto i = 0; i != 6000; ++i)
+        {
+            auto value = random.generate<die>().get_value();
+            REQUIRE(value >= 1);
+            REQUIRE(value <= 6);
+            ++counts[value - 1];
+        }
+        for (auto count : counts)
+        {
+            REQUIRE(count > 800);
+            REQUIRE(count < 1200);
+        }
+
+        using full = bounded_type<long long, true, true,
+                                  std::integral_constant<long long, (-9223372036854775807ll - 1)>,
+                                  std::integral_constant<long long, 9223372036854775807ll>>;
+        random.generate<full>();
+    }
+    SECTION("dynamic bounds")
+    {
+        std::mt19937_64 gen(42u);
+        auto            random = make_bounded_random(gen);
+
+        using dynamic = bounded_type<int, true, false>;
+        for (auto i = 0; i != 1000; ++i)
+        {
+            auto value = random.generate<dynamic>(dynamic::constraint_predicate(-5, 5)).get_value();
+            REQUIRE(value >= -5);
+            REQUIRE(value < 5);
+        }
+
+        auto clamped = random.generate<clamped_type<int>>(
+            clamped_type<int>::constraint_predicate(100, 100));
+        REQUIRE(clamped.get_value() == 100);
+    }
+    SECTION("index")
+    {
+        std::mt19937 gen(42u);
+        auto         random = make_bounded_random(gen);
+
+        for (auto i = 0; i != 1000; ++i)
+            REQUIRE(random.index(10u) < index_t(10u));
+    }
+    SECTION("fill")
+    {
+        std::mt19937 gen(42u);
+        auto         random = make_bounded_random(gen);
+
+        std::vector<die> dice(1000, die(1));
+        random.fill(array_ref<die>(dice.data(), dice.size()));
+        auto sum = 0;
+        for (auto& d : dice)
+            sum += d.get_value();
+        REQUIRE(sum > 3000);
+        REQUIRE(sum < 4000);
+
+        std::vector<index_t> indices(1000);
+        random.fill(array_ref<index_t>(indices.data(), indices.size()), 3u);
+        for (auto idx : indices)
+            REQUIRE(idx < index_t(3u));
+    }
+}
@@ -6,6 +6,11 @@
 
 #include <catch.hpp>
 #include <functional>
+#include <string>
+#include <vector>
+
+#include <type_safe/variant.hpp>
+#include <type_safe/visitor.hpp>
 
 #include "debugger_type.hpp"
 
@@ -198,6 +203,69 @@ TEST_CASE("array_ref")
     }
 }
 
+TEST_CASE("fixed_array_ref")
+{
+    int array[3] = {1, 2, 3};
+
+    fixed_array_ref<int, 3> ref(array);
+    static_assert(decltype(ref)::size() == 3u, "");
+    static_assert(sizeof(ref) == sizeof(int*), "");
+    REQUIRE(ref.data() == array);
+    REQUIRE(ref.begin() == array);
+    REQUIRE(ref.end() == array + 3);
+
+    REQUIRE(ref[0u] == 1);
+    REQUIRE(ref[2u] == 3);
+    ref[1u] = 100;
+    REQUIRE(array[1] == 100);
+
+    SECTION("ctor")
+    {
+        fixed_array_ref<int, 2> a(array + 1);
+        REQUIRE(a.data() == array + 1);
+
+        fixed_array_ref<int, 3> b(array_ref<int>(array, 3u));
+        REQUIRE(b.data() == array);
+    }
+    SECTION("conversion")
+    {
+        array_ref<int> a = ref;
+        REQUIRE(a.data() == array);
+        REQUIRE((a.size() == 3u));
+    }
+    SECTION("with")
+    {
+        auto sum = 0;
+        with(ref, [&](int i) { sum += i; });
+        REQUIRE(sum == 104);
+    }
+}
+
+TEST_CASE("aligned_array_ref")
+{
+    alignas(32) int array[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    aligned_array_ref<int, 32> ref(array, 8u);
+    REQUIRE(ref.data() == array);
+    REQUIRE((ref.size() == 8u));
+    REQUIRE(ref.begin() == array);
+    REQUIRE(ref.end() == array + 8);
+
+    REQUIRE(ref[0u] == 1);
+    ref[7u] = 100;
+    REQUIRE(array[7] == 100);
+
+    aligned_array_ref<int, 16> b(array_ref<int>(array + 4, 4u));
+    REQUIRE(b.data() == array + 4);
+
+    const array_ref<int>& c = ref;
+    REQUIRE(c.data() == array);
+
+    auto sum = 0;
+    with(b, [&](int i) { sum += i; });
+    REQUIRE(sum == 118);
+}
+
 // fake polymorphic lambda, due to C++11 requirement
 struct lambda
 {
@@ -329,3 +397,148 @@ TEST_CASE("function_ref")
         REQUIRE(a() == 1);
     }
 }
+
+namespace
+{
+struct copy_counter
+{
+    static int copies;
+    static int moves;
+
+    copy_counter() = default;
+
+    copy_counter(const copy_counter&)
+    {
+        ++copies;
+    }
+
+    copy_counter(copy_counter&&) noexcept
+    {
+        ++moves;
+    }
+};
+
+int copy_counter::copies = 0;
+int copy_counter::moves  = 0;
+
+void take_by_value(copy_counter) {}
+} // namespace
+
+TEST_CASE("function_ref argument forwarding")
+{
+    copy_counter counter;
+
+    auto check = [&](function_ref<void(copy_counter)> ref) {
+        copy_counter::copies = copy_counter::moves = 0;
+        ref(counter);
+        // copied into the parameter of operator(), moved into the one of the function
+        REQUIRE(copy_counter::copies == 1);
+        REQUIRE(copy_counter::moves == 1);
+
+        copy_counter::copies = copy_counter::moves = 0;
+        ref(copy_counter{});
+        REQUIRE(copy_counter::copies == 0);
+        REQUIRE(copy_counter::moves == 1);
+    };
+
+    SECTION("function pointer")
+    {
+        check(&take_by_value);
+    }
+    SECTION("functor")
+    {
+        auto lambda = [&counter](copy_counter) { (void)counter; };
+        check(function_ref<void(copy_counter)>(lambda));
+    }
+    SECTION("reference parameter")
+    {
+        auto lambda = [](const copy_counter&) {};
+        function_ref<void(copy_counter)> ref(lambda);
+
+        copy_counter::copies = copy_counter::moves = 0;
+        ref(counter);
+        REQUIRE(copy_counter::copies == 1);
+        REQUIRE(copy_counter::moves == 0);
+    }
+    SECTION("std::string and std::vector")
+    {
+        std::string      str(100u, 'a');
+        std::vector<int> vec(100u, 1);
+
+        auto lambda = [](std::string s, std::vector<int> v) {
+            return s.size() + v.size();
+        };
+        function_ref<std::size_t(std::string, std::vector<int>)> ref(lambda);
+        REQUIRE(ref(str, vec) == 200u);
+        REQUIRE(ref(std::move(str), std::move(vec)) == 200u);
+    }
+}
+
+namespace
+{
+struct multi_visitor
+{
+    int calls = 0;
+
+    int operator()(int i)
+    {
+        ++calls;
+        return i;
+    }
+
+    int operator()(const std::string& str)
+    {
+        ++calls;
+        return static_cast<int>(str.size());
+    }
+};
+
+// non-template function, the visitor is type-erased
+int visit_erased(const variant<int, std::string>&                       v,
+                 function_ref<int(const int&), int(const std::string&)> visitor)
+{
+    return visit(visitor, v);
+}
+} // namespace
+
+TEST_CASE("function_ref multiple signatures")
+{
+    multi_visitor                                   visitor;
+    function_ref<int(int), int(const std::string&)> ref(visitor);
+    static_assert(sizeof(ref) == 2 * sizeof(void*), "");
+
+    REQUIRE(ref(4) == 4);
+    REQUIRE(ref(std::string("abc")) == 3);
+    REQUIRE(visitor.calls == 2);
+
+    SECTION("compatible signatures")
+    {
+        function_ref<void(short), long(std::string)> compatible(visitor);
+        compatible(1);
+        REQUIRE(compatible("ab") == 2);
+        REQUIRE(visitor.calls == 4);
+    }
+    SECTION("assignment")
+    {
+        multi_visitor other;
+        ref.assign(other);
+        ref(1);
+        REQUIRE(visitor.calls == 2);
+        REQUIRE(other.calls == 1);
+
+        function_ref<int(int), int(const std::string&)> copy(visitor);
+        copy = ref;
+        copy(1);
+        REQUIRE(other.calls == 2);
+    }
+    SECTION("variant")
+    {
+        variant<int, std::string> v(42);
+        REQUIRE(visit_erased(v, function_ref<int(const int&), int(const std::string&)>(visitor))
+                == 42);
+
+        v = std::string("hello");
+        REQUIRE(visit_erased(v, function_ref<int(const int&), int(const std::string&)>(visitor))
+                == 5);
+    }
+}
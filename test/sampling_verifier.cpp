@@ -0,0 +1,124 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/sampling_verifier.hpp>
+
+#include <catch.hpp>
+
+#include <type_safe/constrained_type.hpp>
+
+using namespace type_safe;
+
+namespace
+{
+struct non_negative
+{
+    bool operator()(int i) const
+    {
+        return i >= 0;
+    }
+};
+
+int handler_calls = 0;
+
+void count_handler_calls()
+{
+    ++handler_calls;
+}
+
+struct sampled_violation
+{};
+
+void throw_violation()
+{
+    throw sampled_violation{};
+}
+} // namespace
+
+TEST_CASE("sampling_verifier")
+{
+    using sampled_int = constrained_type<int, non_negative, sampling_verifier>;
+
+    SECTION("valid")
+    {
+        auto before = sampling_verifier::violation_count();
+        for (auto i = 0; i != 4 * TYPE_SAFE_SAMPLING_RATE; ++i)
+        {
+            sampled_int a(i);
+            REQUIRE(a.get_value() == i);
+        }
+        REQUIRE(sampling_verifier::violation_count() == before);
+    }
+    SECTION("invalid")
+    {
+        auto before = sampling_verifier::violation_count();
+        // no abort, the value is unchanged
+        sampled_int a(-1);
+        REQUIRE(a.get_value() == -1);
+
+        // at least one of them is verified
+        for (auto i = 1; i != TYPE_SAFE_SAMPLING_RATE; ++i)
+            sampled_int b(-1);
+        REQUIRE(sampling_verifier::violation_count() > before);
+    }
+    SECTION("handler")
+    {
+        auto old      = sampling_verifier::set_violation_handler(&count_handler_calls);
+        handler_calls = 0;
+
+        auto before = sampling_verifier::violation_count();
+        for (auto i = 0; i != TYPE_SAFE_SAMPLING_RATE; ++i)
+            sampled_int a(-1);
+        auto violations = sampling_verifier::violation_count() - before;
+        REQUIRE(violations == 1u);
+        REQUIRE(handler_calls == 1);
+
+        REQUIRE(sampling_verifier::set_violation_handler(old) == &count_handler_calls);
+    }
+    SECTION("access")
+    {
+        sampled_int a(-1);
+
+        // accessing the value is not verified
+        auto before = sampling_verifier::violation_count();
+        for (auto i = 0; i != 2 * TYPE_SAFE_SAMPLING_RATE; ++i)
+            REQUIRE(a.get_value() == -1);
+        REQUIRE(sampling_verifier::violation_count() == before);
+    }
+    SECTION("throwing handler")
+    {
+        auto old = sampling_verifier::set_violation_handler(&throw_violation);
+
+        auto thrown = 0;
+        for (auto i = 0; i != TYPE_SAFE_SAMPLING_RATE; ++i)
+        {
+            try
+            {
+                sampled_int a(-1);
+            }
+            catch (sampled_violation&)
+            {
+                ++thrown;
+            }
+        }
+        REQUIRE(thrown == 1);
+
+        sampled_int b(0);
+        thrown = 0;
+        for (auto i = 0; i != TYPE_SAFE_SAMPLING_RATE; ++i)
+        {
+            try
+            {
+                b = -1;
+            }
+            catch (sampled_violation&)
+            {
+                ++thrown;
+            }
+        }
+        REQUIRE(thrown == 1);
+
+        sampling_verifier::set_violation_handler(old);
+    }
+}
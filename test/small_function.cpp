@@ -0,0 +1,158 @@
+// Copyright (C) 2016-2019 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/small_function.hpp>
+
+#include <catch.hpp>
+
+#include <memory>
+#include <string>
+
+using namespace type_safe;
+
+namespace
+{
+int add(int a, int b)
+{
+    return a + b;
+}
+
+struct counted
+{
+    static int instances;
+
+    counted() noexcept
+    {
+        ++instances;
+    }
+
+    counted(const counted&) noexcept
+    {
+        ++instances;
+    }
+
+    ~counted() noexcept
+    {
+        --instances;
+    }
+
+    int operator()(int a, int b) const
+    {
+        return a * b;
+    }
+};
+
+int counted::instances = 0;
+} // namespace
+
+TEST_CASE("small_function")
+{
+    SECTION("empty")
+    {
+        small_function<void()> a;
+        REQUIRE(!a);
+
+        small_function<void()> b(nullptr);
+        REQUIRE(!b);
+    }
+    SECTION("function pointer")
+    {
+        small_function<int(int, int)> a(&add);
+        REQUIRE(a);
+        REQUIRE(a(1, 2) == 3);
+
+        // compatible signature
+        small_function<void(short, short)> b(&add);
+        b(1, 2);
+    }
+    SECTION("lambda")
+    {
+        auto                     value = 4;
+        small_function<int(int)> a([value](int i) { return value * i; });
+        REQUIRE(a(2) == 8);
+
+        // mutable lambdas are allowed
+        small_function<int()> counter([value]() mutable { return value++; });
+        REQUIRE(counter() == 4);
+        REQUIRE(counter() == 5);
+
+        // conversions of the return type
+        small_function<std::string()> c([] { return "abc"; });
+        REQUIRE(c() == "abc");
+    }
+    SECTION("move-only")
+    {
+        std::unique_ptr<int> ptr(new int(42));
+
+        struct owner
+        {
+            std::unique_ptr<int> ptr;
+
+            int operator()()
+            {
+                return *ptr;
+            }
+        };
+        small_function<int()> a(owner{std::move(ptr)});
+        REQUIRE(a() == 42);
+
+        small_function<int()> b(std::move(a));
+        REQUIRE(!a);
+        REQUIRE(b() == 42);
+
+        a = std::move(b);
+        REQUIRE(!b);
+        REQUIRE(a() == 42);
+
+        a = nullptr;
+        REQUIRE(!a);
+    }
+    SECTION("lifetime")
+    {
+        counted::instances = 0;
+        {
+            small_function<int(int, int)> a(counted{});
+            REQUIRE(counted::instances == 1);
+            REQUIRE(a(2, 3) == 6);
+
+            small_function<int(int, int)> b(std::move(a));
+            REQUIRE(counted::instances == 1);
+            REQUIRE(b(2, 4) == 8);
+
+            b.reset();
+            REQUIRE(counted::instances == 0);
+
+            b = counted{};
+            REQUIRE(counted::instances == 1);
+        }
+        REQUIRE(counted::instances == 0);
+    }
+    SECTION("argument forwarding")
+    {
+        counted::instances = 0;
+        small_function<std::size_t(std::string, counted)> a(
+            [](std::string str, counted) { return str.size(); });
+        REQUIRE(a("abc", counted{}) == 3u);
+        REQUIRE(counted::instances == 0);
+    }
+    SECTION("buffer size")
+    {
+        char big[64] = {};
+        auto lambda  = [big] { return big[0]; };
+
+        static_assert(!std::is_constructible<small_function<char()>, int>::value, "");
+        small_function<char(), sizeof(lambda)> a(lambda);
+        REQUIRE(a() == 0);
+    }
+    SECTION("move-only")
+    {
+        using func = small_function<int(int)>;
+        static_assert(!std::is_copy_constructible<func>::value, "");
+        static_assert(!std::is_copy_assignable<func>::value, "");
+        static_assert(!std::is_constructible<func, func&>::value, "");
+        static_assert(!std::is_constructible<func, const func&>::value, "");
+        static_assert(std::is_nothrow_move_constructible<func>::value, "");
+        static_assert(std::is_nothrow_move_assignable<func>::value, "");
+    }
+}
@@ -604,4 +604,22 @@ TEST_CASE("strong_typedef")
         type b(foo{true});
         REQUIRE(b);
     }
+    SECTION("select")
+    {
+        struct type : strong_typedef<type, int>
+        {
+            using strong_typedef::strong_typedef;
+        };
+
+        REQUIRE(get(type_safe::select(true, type(1), type(2))) == 1);
+        REQUIRE(get(type_safe::select(false, type(1), type(2))) == 2);
+
+        struct nested : strong_typedef<nested, type>
+        {
+            using strong_typedef::strong_typedef;
+        };
+
+        REQUIRE(get(get(type_safe::select(true, nested(type(1)), nested(type(2))))) == 1);
+        REQUIRE(get(get(type_safe::select(false, nested(type(1)), nested(type(2))))) == 2);
+    }
 }